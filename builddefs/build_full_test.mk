@@ -30,6 +30,12 @@ $(TEST_OUTPUT)_SRC := \
 	tests/test_common/test_logger.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 
+ifeq ($(strip $(BENCH)), yes)
+$(TEST_OUTPUT)_SRC += \
+	tests/test_common/bench_alloc.c \
+	tests/test_common/bench_fixture.cpp
+endif
+
 $(TEST_OUTPUT)_DEFS := $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
 
 $(TEST_OUTPUT)_CONFIG := $(TEST_PATH)/config.h
@@ -55,8 +55,16 @@ endif
 
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
+ifneq ($(wildcard $(TEST_PATH)/bench.mk),)
+BENCH := yes
+# Benchmarks measure optimised code and time their hot paths with the profiler
+OPT = 2
+PROFILER_ENABLE = yes
+include $(TEST_PATH)/bench.mk
+else
 include $(TEST_PATH)/test.mk
 endif
+endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
@@ -66,6 +74,8 @@ include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
+include $(QUANTUM_PATH)/tests/matrix/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
 include $(PLATFORM_PATH)/test/rules.mk
@@ -352,6 +352,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix_drivers.c
+    SRC += $(QUANTUM_DIR)/last_hit.c
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
 
@@ -472,6 +473,8 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
+    SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_neighbours.c
+    SRC += $(QUANTUM_DIR)/last_hit.c
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
 
@@ -659,6 +662,11 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
     ifneq ($(strip $(CUSTOM_MATRIX)), lite)
         # Include the standard or split matrix code if needed
         QUANTUM_SRC += $(QUANTUM_DIR)/matrix.c
+
+        ifeq ($(strip $(MATRIX_IDLE_WAKEUP_ENABLE)), yes)
+            OPT_DEFS += -DMATRIX_IDLE_WAKEUP_ENABLE
+            QUANTUM_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_wakeup.c
+        endif
     endif
 endif
 
@@ -44,6 +44,7 @@ GENERIC_FEATURES = \
     MOUSEKEY \
     MUSIC \
     OS_DETECTION \
+    PROFILER \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
@@ -1,10 +1,13 @@
 TEST_LIST = $(sort $(patsubst %/test.mk,%, $(shell find $(ROOT_DIR)tests -type f -name test.mk)))
-FULL_TESTS := $(notdir $(TEST_LIST))
+BENCH_LIST = $(sort $(patsubst %/bench.mk,%, $(shell find $(ROOT_DIR)tests/bench -type f -name bench.mk)))
+FULL_TESTS := $(notdir $(TEST_LIST) $(BENCH_LIST))
 
 include $(QUANTUM_PATH)/debounce/tests/testlist.mk
 include $(QUANTUM_PATH)/encoder/tests/testlist.mk
 include $(QUANTUM_PATH)/os_detection/tests/testlist.mk
 include $(QUANTUM_PATH)/sequencer/tests/testlist.mk
+include $(QUANTUM_PATH)/split_common/tests/testlist.mk
+include $(QUANTUM_PATH)/tests/matrix/testlist.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/testlist.mk
 include $(PLATFORM_PATH)/test/testlist.mk
 
@@ -31,6 +31,8 @@ bool qp_comms_spi_start(painter_device_t device) {
 }
 
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
+    qp_comms_spi_fence(device);
+
     uint32_t       bytes_remaining = byte_count;
     const uint8_t *p               = (const uint8_t *)data;
     const uint32_t max_msg_length  = 1024;
@@ -45,18 +47,38 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+uint32_t qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    // Larger transfers than a single SPI transaction allows are sent synchronously
+    if (byte_count > UINT16_MAX) {
+        return qp_comms_spi_send_data(device, data, byte_count);
+    }
+
+    qp_comms_spi_fence(device);
+    if (spi_transmit_async((const uint8_t *)data, byte_count) != SPI_STATUS_SUCCESS) {
+        return 0;
+    }
+    return byte_count;
+}
+
+void qp_comms_spi_fence(painter_device_t device) {
+    spi_transmit_wait();
+}
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
+    qp_comms_spi_fence(device);
     spi_stop();
     gpio_write_pin_high(comms_config->chip_select_pin);
 }
 
 const painter_comms_vtable_t spi_comms_vtable = {
-    .comms_init  = qp_comms_spi_init,
-    .comms_start = qp_comms_spi_start,
-    .comms_send  = qp_comms_spi_send_data,
-    .comms_stop  = qp_comms_spi_stop,
+    .comms_init       = qp_comms_spi_init,
+    .comms_start      = qp_comms_spi_start,
+    .comms_send       = qp_comms_spi_send_data,
+    .comms_stop       = qp_comms_spi_stop,
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_fence      = qp_comms_spi_fence,
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,9 +119,18 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+uint32_t qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    gpio_write_pin_high(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    // D/C must not change while pixel data is still being sent
+    qp_comms_spi_fence(device);
     gpio_write_pin_low(comms_config->dc_pin);
     spi_write(cmd);
 }
@@ -131,10 +162,12 @@ void qp_comms_spi_dc_reset_bulk_command_sequence(painter_device_t device, const
 const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
     .base =
         {
-            .comms_init  = qp_comms_spi_dc_reset_init,
-            .comms_start = qp_comms_spi_start,
-            .comms_send  = qp_comms_spi_dc_reset_send_data,
-            .comms_stop  = qp_comms_spi_stop,
+            .comms_init       = qp_comms_spi_dc_reset_init,
+            .comms_start      = qp_comms_spi_start,
+            .comms_send       = qp_comms_spi_dc_reset_send_data,
+            .comms_stop       = qp_comms_spi_stop,
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_fence      = qp_comms_spi_fence,
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -21,6 +21,23 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_RECTS
+/**
+ * @def This controls the number of separate dirty regions each surface keeps track of. Changes far apart from each other
+ *      are transferred to the display as separate regions, rather than as one region covering everything in between.
+ *      Setting this to 1 tracks a single bounding box.
+ */
+#    define SURFACE_DIRTY_RECTS 4
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_DISTANCE
+/**
+ * @def This controls how close (in pixels) a change must be to an existing dirty region to extend it, instead of
+ *      starting a new one. Each region costs a viewport command when transferred, so nearby changes are grouped.
+ */
+#    define SURFACE_DIRTY_MERGE_DISTANCE 8
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -53,7 +70,8 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
 /**
  * Helper method to draw the contents of the framebuffer to the target device.
  *
- * After successful completion, the dirty area is reset.
+ * Only the dirty regions are transferred, unless the entire surface is requested. After successful completion, the dirty
+ * regions are reset.
  *
  * @param surface[in] the surface to copy from
  * @param target[in] the target device to copy into
@@ -29,23 +29,74 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
-void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
-    // Maintain dirty region
-    if (dirty->l > x) {
-        dirty->l        = x;
-        dirty->is_dirty = true;
+static inline bool qp_surface_dirty_rect_overlaps(const surface_dirty_rect_t *a, const surface_dirty_rect_t *b) {
+    return a->l <= b->r && b->l <= a->r && a->t <= b->b && b->t <= a->b;
+}
+
+// Distance from the region to the pixel, along whichever axis it's furthest out
+static inline uint16_t qp_surface_dirty_rect_distance(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    uint16_t dx = x < rect->l ? rect->l - x : (x > rect->r ? x - rect->r : 0);
+    uint16_t dy = y < rect->t ? rect->t - y : (y > rect->b ? y - rect->b : 0);
+    return QP_MAX(dx, dy);
+}
+
+// Grows the region to include the pixel, absorbing any other regions it now overlaps
+static void qp_surface_dirty_rect_extend(surface_dirty_data_t *dirty, uint8_t index, uint16_t x, uint16_t y) {
+    surface_dirty_rect_t *rect = &dirty->rects[index];
+    rect->l                    = QP_MIN(rect->l, x);
+    rect->t                    = QP_MIN(rect->t, y);
+    rect->r                    = QP_MAX(rect->r, x);
+    rect->b                    = QP_MAX(rect->b, y);
+
+    for (uint8_t i = 0; i < dirty->count;) {
+        surface_dirty_rect_t *other = &dirty->rects[i];
+        if (i == index || !qp_surface_dirty_rect_overlaps(rect, other)) {
+            ++i;
+            continue;
+        }
+
+        rect->l = QP_MIN(rect->l, other->l);
+        rect->t = QP_MIN(rect->t, other->t);
+        rect->r = QP_MAX(rect->r, other->r);
+        rect->b = QP_MAX(rect->b, other->b);
+
+        // Move the last region into the freed slot, keeping track of the one being extended
+        *other = dirty->rects[--dirty->count];
+        if (index == dirty->count) {
+            index = i;
+            rect  = other;
+        }
+        i = 0;
     }
-    if (dirty->r < x) {
-        dirty->r        = x;
-        dirty->is_dirty = true;
+    dirty->last = index;
+}
+
+void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    // Pixels are mostly written in runs, so the region extended last is the most likely one to already contain this one
+    if (dirty->count > 0 && qp_surface_dirty_rect_distance(&dirty->rects[dirty->last], x, y) == 0) {
+        return;
     }
-    if (dirty->t > y) {
-        dirty->t        = y;
-        dirty->is_dirty = true;
+
+    uint8_t  nearest  = 0;
+    uint16_t distance = UINT16_MAX;
+    for (uint8_t i = 0; i < dirty->count; ++i) {
+        uint16_t d = qp_surface_dirty_rect_distance(&dirty->rects[i], x, y);
+        if (d < distance) {
+            distance = d;
+            nearest  = i;
+        }
     }
-    if (dirty->b < y) {
-        dirty->b        = y;
-        dirty->is_dirty = true;
+
+    dirty->is_dirty = true;
+    if (distance == 0) {
+        dirty->last = nearest;
+    } else if (distance > SURFACE_DIRTY_MERGE_DISTANCE && dirty->count < SURFACE_DIRTY_RECTS) {
+        // Far enough away from everything else to be worth its own region
+        dirty->rects[dirty->count] = (surface_dirty_rect_t){.l = x, .t = y, .r = x, .b = y};
+        dirty->last                = dirty->count++;
+    } else {
+        // Close by, or out of regions -- the pixels in between get transferred unchanged
+        qp_surface_dirty_rect_extend(dirty, nearest, x, y);
     }
 }
 
@@ -57,10 +108,9 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
 
-    surface->dirty.l        = 0;
-    surface->dirty.t        = 0;
-    surface->dirty.r        = surface->base.panel_width - 1;
-    surface->dirty.b        = surface->base.panel_height - 1;
+    surface->dirty.rects[0] = (surface_dirty_rect_t){.l = 0, .t = 0, .r = surface->base.panel_width - 1, .b = surface->base.panel_height - 1};
+    surface->dirty.count    = 1;
+    surface->dirty.last     = 0;
     surface->dirty.is_dirty = true;
 
     return true;
@@ -80,9 +130,9 @@ bool qp_surface_clear(painter_device_t device) {
 bool qp_surface_flush(painter_device_t device) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
-    surface->dirty.l = surface->dirty.t = UINT16_MAX;
-    surface->dirty.r = surface->dirty.b = 0;
-    surface->dirty.is_dirty             = false;
+    surface->dirty.count    = 0;
+    surface->dirty.last     = 0;
+    surface->dirty.is_dirty = false;
     return true;
 }
 
@@ -16,12 +16,18 @@ typedef struct surface_painter_driver_vtable_t {
     bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
 } surface_painter_driver_vtable_t;
 
-typedef struct surface_dirty_data_t {
-    bool     is_dirty;
+typedef struct surface_dirty_rect_t {
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+} surface_dirty_rect_t;
+
+typedef struct surface_dirty_data_t {
+    bool                 is_dirty;
+    uint8_t              count; // number of regions in use
+    uint8_t              last;  // region most recently extended, checked first
+    surface_dirty_rect_t rects[SURFACE_DIRTY_RECTS];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -50,7 +56,7 @@ typedef struct surface_painter_device_t {
     // Manually manage the viewport for streaming pixel data to the display
     surface_viewport_data_t viewport;
 
-    // Maintain a dirty region so we can stream only what we need
+    // Maintain dirty regions so we can stream only what we need
     surface_dirty_data_t dirty;
 } surface_painter_device_t;
 
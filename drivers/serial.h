@@ -28,6 +28,16 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Queues the transaction on the transport thread, to run after those already queued. Returns false if the queue is full.
+bool soft_serial_async_transaction(int sstd_index);
+// Whether any of the queued transactions is still running
+bool soft_serial_async_busy(void);
+// Outcome of the oldest queued transaction whose outcome hasn't been taken yet, once all of them have finished.
+// ticks is set to the time from queueing to completion in profiler counter ticks, with PROFILER_ENABLE, 0 otherwise.
+bool soft_serial_async_result(uint32_t *ticks);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -93,6 +93,26 @@ spi_status_t spi_read(void);
  */
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 
+/**
+ * \brief Start sending multiple bytes to the selected SPI device, without waiting for the transfer to complete.
+ *
+ * On platforms without asynchronous transfers this behaves like `spi_transmit()`. The data must remain valid and unchanged
+ * until `spi_transmit_wait()` has returned. Any other SPI operation waits for the transfer to complete first.
+ *
+ * \param data A pointer to the data to write from.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ *
+ * \return `SPI_STATUS_ERROR` if the transfer could not be started, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+/**
+ * \brief Wait for a transfer started by `spi_transmit_async()` to complete.
+ *
+ * \return `SPI_STATUS_SUCCESS` once no transfer is in progress.
+ */
+spi_status_t spi_transmit_wait(void);
+
 /**
  * \brief Receive multiple bytes from the selected SPI device.
  *
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include <stdbool.h>
 #include <hal.h>
+#include "compiler_support.h"
 #include "util.h"
 #include "timer.h"
 #include "wear_leveling.h"
@@ -42,6 +43,28 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+// The SPI flash driver waits for each erase itself, so the erase has completed by the time it is polled.
+bool backing_store_erase_sector_start(uint32_t address) {
+    // Each bank sector has to map onto whole flash sectors.
+    STATIC_ASSERT((WEAR_LEVELING_SECTOR_SIZE) % (EXTERNAL_FLASH_SECTOR_SIZE) == 0, "WEAR_LEVELING_SECTOR_SIZE must be a multiple of EXTERNAL_FLASH_SECTOR_SIZE");
+
+    bs_dprintf("Erase sector %08lX\n", (unsigned long)address);
+    uint32_t offset = (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address;
+    for (uint32_t i = 0; i < (WEAR_LEVELING_SECTOR_SIZE); i += (EXTERNAL_FLASH_SECTOR_SIZE)) {
+        if (flash_erase_sector(offset + i) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool backing_store_erase_sector_poll(bool *done) {
+    *done = true;
+    return true;
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -28,7 +28,16 @@
 #    define WEAR_LEVELING_BACKING_SIZE ((EXTERNAL_FLASH_BLOCK_SIZE) * (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT))
 #endif // WEAR_LEVELING_BACKING_SIZE
 
-// Use half of the backing size for logical EEPROM
+// Use half of the backing size for logical EEPROM, or half of each bank with background consolidation
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
+
+// Background consolidation erases one flash sector at a time
+#if defined(WEAR_LEVELING_ASYNC_CONSOLIDATION) && !defined(WEAR_LEVELING_SECTOR_SIZE)
+#    define WEAR_LEVELING_SECTOR_SIZE (EXTERNAL_FLASH_SECTOR_SIZE)
+#endif // WEAR_LEVELING_SECTOR_SIZE
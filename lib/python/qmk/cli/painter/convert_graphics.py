@@ -13,6 +13,7 @@ from PIL import Image
 @cli.argument('-f', '--format', required=True, help=f'Output format, valid types: {", ".join(valid_formats.keys())}')
 @cli.argument('-r', '--no-rle', arg_only=True, action='store_true', help='Disables the use of RLE when encoding images.')
 @cli.argument('-d', '--no-deltas', arg_only=True, action='store_true', help='Disables the use of delta frames when encoding animations.')
+@cli.argument('-m', '--no-delta-rects', arg_only=True, action='store_true', help='Disables the use of multiple rectangles in delta frames when encoding animations.')
 @cli.argument('-w', '--raw', arg_only=True, action='store_true', help='Writes out the QGF file as raw data instead of c/h combo.')
 @cli.subcommand('Converts an input image to something QMK understands')
 def painter_convert_graphics(cli):
@@ -50,7 +51,7 @@ def painter_convert_graphics(cli):
     # Convert the image to QGF using PIL
     out_data = BytesIO()
     metadata = []
-    input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata)
+    input_img.save(out_data, "QGF", use_deltas=(not cli.args.no_deltas), use_delta_rects=(not cli.args.no_delta_rects), use_rle=(not cli.args.no_rle), qmk_format=format, verbose=cli.args.verbose, metadata=metadata)
     out_bytes = out_data.getvalue()
 
     if cli.args.raw:
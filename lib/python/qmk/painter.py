@@ -122,11 +122,19 @@ def _render_image_metadata(metadata):
             if not v["delta"]:
                 continue
 
+            px = size["width"] * size["height"]
+
+            # Multiple rectangles, summarise them
+            if "delta_rects" in v:
+                rects = v["delta_rects"]
+                delta_px = sum((right - left + 1) * (bottom - top + 1) for left, top, right, bottom in rects)
+                deltas.append(f"// Frame {i:3d}: {len(rects):3d} rects >> {delta_px:4d}/{px:4d} pixels ({100*delta_px/px:.2f}%)")
+                continue
+
             # Unpack rect's coords
             l, t, r, b = v["delta_rect"]
 
             delta_px = (r - l) * (b - t)
-            px = size["width"] * size["height"]
 
             # FIXME: May need need more chars here too
             deltas.append(f"// Frame {i:3d}: ({l:3d}, {t:3d}) - ({r:3d}, {b:3d}) >> {delta_px:4d}/{px:4d} pixels ({100*delta_px/px:.2f}%)")
@@ -449,7 +457,7 @@ def compress_bytes_qmk_rle(bytearray):
                     append_range(temp[0:(len(temp) - 2)])
                     temp = [temp[-1], temp[-1]]
                 continue
-            if len(temp) == 128 or end:
+            if len(temp) == 128 or (end and temp):
                 append_range(temp)
                 temp = []
                 repeat = False
@@ -147,6 +147,17 @@ class QGFFrameDescriptorV1:
         else:
             self.flags &= ~0x02
 
+    @property
+    def is_delta_rects(self):
+        return (self.flags & 0x04) == 0x04
+
+    @is_delta_rects.setter
+    def is_delta_rects(self, val):
+        if val:
+            self.flags |= 0x04
+        else:
+            self.flags &= ~0x04
+
 
 ########################################################################################################################
 
@@ -208,6 +219,30 @@ class QGFFrameDeltaDescriptorV1:
 ########################################################################################################################
 
 
+class QGFFrameDeltaRectsDescriptorV1:
+    type_id = 0x06
+    rect_length = 8
+
+    def __init__(self):
+        self.header = QGFBlockHeader()
+        self.header.type_id = QGFFrameDeltaRectsDescriptorV1.type_id
+        self.rects = []
+
+    def write(self, fp):
+        self.header.length = len(self.rects) * QGFFrameDeltaRectsDescriptorV1.rect_length
+        self.header.write(fp)
+        for left, top, right, bottom in self.rects:
+            fp.write(b''  # start off with empty bytes...
+                     + o16(left)  # left
+                     + o16(top)  # top
+                     + o16(right)  # right
+                     + o16(bottom)  # bottom
+                     )
+
+
+########################################################################################################################
+
+
 class QGFFrameDataDescriptorV1:
     type_id = 0x05
 
@@ -260,7 +295,61 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
+def _find_delta_rects(diff, tile_size):
+    """Finds a set of rectangles covering all the changed pixels of a frame.
+
+    The frame is split into tiles, horizontally adjacent changed tiles are merged into runs, and runs spanning the same
+    columns on consecutive tile rows are merged into rectangles. Each rectangle is then shrunk to the changes within it.
+    """
+    width, height = diff.size
+    rects = []
+    open_rects = {}
+    for top in range(0, height, tile_size):
+        bottom = min(top + tile_size, height)
+
+        # Work out the runs of changed tiles on this row
+        runs = []
+        for left in range(0, width, tile_size):
+            right = min(left + tile_size, width)
+            if diff.crop((left, top, right, bottom)).getbbox():
+                if runs and runs[-1][1] == left:
+                    runs[-1][1] = right
+                else:
+                    runs.append([left, right])
+
+        # Extend the rectangles above with matching runs, closing off the rest
+        next_open_rects = {}
+        for left, right in runs:
+            rect = open_rects.pop((left, right), [left, top, right, top])
+            rect[3] = bottom
+            next_open_rects[(left, right)] = rect
+        rects.extend(open_rects.values())
+        open_rects = next_open_rects
+    rects.extend(open_rects.values())
+
+    # Shrink each rectangle to the pixels that actually changed
+    shrunk = []
+    for left, top, right, bottom in rects:
+        changed = diff.crop((left, top, right, bottom)).getbbox()
+        shrunk.append((left + changed[0], top + changed[1], left + changed[2], top + changed[3]))
+    return shrunk
+
+
+def _compress_delta_rects(converted, rects, *, use_rle, format_):
+    """Encodes the given rectangles of an already-converted frame, each compressed independently.
+    """
+    raw_data = []
+    rle_data = []
+    for rect in rects:
+        rect_data = qmk.painter.convert_image_bytes(converted.crop(rect), format_)[1]
+        raw_data.extend(rect_data)
+        if use_rle:
+            rle_data.extend(qmk.painter.compress_bytes_qmk_rle(rect_data))
+    use_raw = not use_rle or len(raw_data) <= len(rle_data)
+    return (raw_data if use_raw else rle_data), use_raw
+
+
+def _compress_image(frame, last_frame, *, use_rle, use_deltas, use_delta_rects, format_, **_kwargs):
     # Convert the original frame so we can do comparisons
     converted = qmk.painter.convert_requested_format(frame, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
@@ -273,7 +362,9 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
     image_data = raw_data if use_raw_this_frame else rle_data
 
     # Work out if a delta frame is smaller than injecting it directly
+    frame_graphic_data = graphic_data
     use_delta_this_frame = False
+    delta_rects = None
     bbox = None
     if use_deltas and last_frame is not None:
         # If we want to use deltas, then find the difference
@@ -310,6 +401,24 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
                 image_data = delta_image_data
                 use_delta_this_frame = True
 
+        # Multiple rectangles only pay off if the changes are spread out, try a few tile sizes and keep the smallest.
+        # All rectangles share the palette of the whole frame, so they're cut from the converted frame.
+        if use_delta_rects and bbox:
+            best_size = len(image_data) + (QGFFrameDeltaDescriptorV1.length if use_delta_this_frame else 0)
+            for tile_size in (8, 16, 32):
+                rects = _find_delta_rects(diff, tile_size)
+                if len(rects) < 2:
+                    continue
+                rects_image_data, rects_use_raw = _compress_delta_rects(converted, rects, use_rle=use_rle, format_=format_)
+                rects_size = len(rects_image_data) + len(rects) * QGFFrameDeltaRectsDescriptorV1.rect_length
+                if rects_size < best_size:
+                    best_size = rects_size
+                    graphic_data = frame_graphic_data
+                    use_raw_this_frame = rects_use_raw
+                    image_data = rects_image_data
+                    use_delta_this_frame = True
+                    delta_rects = [(left, top, right - 1, bottom - 1) for left, top, right, bottom in rects]
+
         # Default to whole image
         bbox = bbox or [0, 0, *frame.size]
         # Fix sze (as per #20296), we need to cast first as tuples are inmutable
@@ -322,6 +431,7 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
         "graphic_data": graphic_data,
         "image_data": image_data,
         "use_delta_this_frame": use_delta_this_frame,
+        "delta_rects": delta_rects,
         "use_raw_this_frame": use_raw_this_frame,
     }
 
@@ -338,6 +448,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
     use_delta_this_frame = outputs["use_delta_this_frame"]
+    delta_rects = outputs["delta_rects"]
     use_raw_this_frame = outputs["use_raw_this_frame"]
 
     # Write out the frame descriptor
@@ -345,6 +456,7 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
     vprint(f'{f"Frame {idx:3d} base":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_descriptor = QGFFrameDescriptorV1()
     frame_descriptor.is_delta = use_delta_this_frame
+    frame_descriptor.is_delta_rects = delta_rects is not None
     frame_descriptor.is_transparent = False
     frame_descriptor.format = format_['image_format_byte']
     frame_descriptor.compression = 0x00 if use_raw_this_frame else 0x01  # See qp.h, painter_compression_t
@@ -362,7 +474,15 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
         palette_descriptor.write(fp)
 
     # Write out the delta info if required
-    if use_delta_this_frame:
+    if delta_rects is not None:
+        # Set up the rendering locations of each of the delta rectangles
+        delta_rects_descriptor = QGFFrameDeltaRectsDescriptorV1()
+        delta_rects_descriptor.rects = delta_rects
+
+        # Write the delta rectangles to the output
+        vprint(f'{f"Frame {idx:3d} delta rects":26s} {fp.tell():5d}d / {fp.tell():04X}h')
+        delta_rects_descriptor.write(fp)
+    elif use_delta_this_frame:
         # Set up the rendering location of where the delta frame should be situated
         delta_descriptor = QGFFrameDeltaDescriptorV1()
         delta_descriptor.bbox = bbox
@@ -377,7 +497,9 @@ def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwarg
         "delta": frame_descriptor.is_delta,
         "delay": frame_descriptor.delay,
     }
-    if frame_metadata["delta"]:
+    if delta_rects is not None:
+        frame_metadata.update({"delta_rects": [list(rect) for rect in delta_rects]})
+    elif frame_metadata["delta"]:
         frame_metadata.update({"delta_rect": [
             delta_descriptor.left,
             delta_descriptor.top,
@@ -437,7 +559,16 @@ def _save(im, fp, _filename):
     frame_offsets.write(fp)
 
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
+    write_frame = functools.partial(
+        _write_frame,
+        format_=encoderinfo["qmk_format"],
+        fp=fp,
+        use_deltas=encoderinfo.get("use_deltas", True),
+        use_delta_rects=encoderinfo.get("use_delta_rects", True),
+        use_rle=encoderinfo.get("use_rle", True),
+        frame_offsets=frame_offsets,
+        metadata=metadata
+    )
     for_all_frames(write_frame)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
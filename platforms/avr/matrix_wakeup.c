@@ -0,0 +1,20 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/sleep.h>
+#include "matrix_wakeup.h"
+#include "timer.h"
+
+// Pin change interrupts are limited to a few ports and cannot be assigned to arbitrary matrix pins,
+// so the millisecond timer interrupt wakes the MCU instead and bounds the wakeup latency.
+void matrix_wakeup_arm_pin(pin_t pin) {}
+
+void matrix_wakeup_disarm_pin(pin_t pin) {}
+
+void matrix_wakeup_wait(uint16_t timeout_ms) {
+    uint16_t start = timer_read();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    do {
+        sleep_mode();
+    } while (timer_elapsed(start) < timeout_ms);
+}
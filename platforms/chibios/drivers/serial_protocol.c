@@ -7,6 +7,10 @@
 #include "serial_protocol.h"
 #include "synchronization_util.h"
 
+#if defined(SPLIT_TRANSPORT_ASYNC) && defined(PROFILER_ENABLE)
+#    include "profiler.h"
+#endif
+
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
@@ -38,11 +42,94 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+#    ifndef SERIAL_ASYNC_QUEUE_SIZE
+#        define SERIAL_ASYNC_QUEUE_SIZE 2
+#    endif
+
+static binary_semaphore_t async_request;
+static int                async_index[SERIAL_ASYNC_QUEUE_SIZE];
+static bool               async_okay[SERIAL_ASYNC_QUEUE_SIZE];
+static volatile uint8_t   async_queued = 0; // Written by the main loop only
+static volatile uint8_t   async_done   = 0; // Written by the transport thread, and by the main loop once it is idle
+static uint8_t            async_taken  = 0;
+#    ifdef PROFILER_ENABLE
+static uint32_t async_queued_at[SERIAL_ASYNC_QUEUE_SIZE];
+static uint32_t async_done_at[SERIAL_ASYNC_QUEUE_SIZE];
+#    endif // PROFILER_ENABLE
+
+/**
+ * @brief This thread runs on the master and moves the bytes of the queued
+ * transactions in order, the main loop keeps scanning while it waits for the
+ * USART interrupts. Preparing the buffers and handling the results is left to
+ * the main loop.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_request);
+        while (async_done < async_queued) {
+            async_okay[async_done] = soft_serial_transaction(async_index[async_done]);
+#    ifdef PROFILER_ENABLE
+            async_done_at[async_done] = profiler_read_counter();
+#    endif // PROFILER_ENABLE
+            async_done++;
+        }
+    }
+}
+
+bool soft_serial_async_transaction(int index) {
+    if (async_queued >= SERIAL_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    async_index[async_queued] = index;
+#    ifdef PROFILER_ENABLE
+    async_queued_at[async_queued] = profiler_read_counter();
+#    endif // PROFILER_ENABLE
+    async_queued++;
+    chBSemSignal(&async_request);
+    return true;
+}
+
+bool soft_serial_async_busy(void) {
+    return async_done < async_queued;
+}
+
+bool soft_serial_async_result(uint32_t *ticks) {
+    *ticks = 0;
+    if (soft_serial_async_busy() || async_taken >= async_queued) {
+        return false;
+    }
+#    ifdef PROFILER_ENABLE
+    *ticks = async_done_at[async_taken] - async_queued_at[async_taken];
+#    endif // PROFILER_ENABLE
+    bool okay = async_okay[async_taken++];
+    if (async_taken == async_queued) {
+        /* The thread is idle, reset the count it compares against first. */
+        async_queued = 0;
+        async_done   = 0;
+        async_taken  = 0;
+    }
+    return okay;
+}
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    chBSemObjectInit(&async_request, true);
+    /* Above the main loop so that completed transfers are handled right away. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), NORMALPRIO + 1, MasterThread, NULL);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
 /**
@@ -100,6 +187,10 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+    /* Held across the whole transaction, so that a transaction started from
+     * the main loop waits for the one running on the transport thread. */
+    split_shared_memory_lock_autounlock();
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
@@ -117,8 +208,6 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
         return false;
     }
 
-    split_shared_memory_lock_autounlock();
-
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
     /* Send transaction table index to the slave, which doubles as basic handshake token. */
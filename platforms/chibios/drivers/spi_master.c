@@ -438,6 +438,7 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
 
 spi_status_t spi_write(uint8_t data) {
     uint8_t rxData;
+    spi_transmit_wait();
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
     return rxData;
@@ -445,22 +446,42 @@ spi_status_t spi_write(uint8_t data) {
 
 spi_status_t spi_read(void) {
     uint8_t data = 0;
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, 1, &data);
 
     return data;
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
+    if (!spiStarted) {
+        return SPI_STATUS_ERROR;
+    }
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+    // The driver returns to SPI_READY from the DMA completion interrupt
+    while (*(volatile spistate_t *)&SPI_DRIVER.state == SPI_ACTIVE) {
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_transmit_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
+    spi_transmit_wait();
     if (spiStarted) {
         spi_unselect();
         spiStop(&SPI_DRIVER);
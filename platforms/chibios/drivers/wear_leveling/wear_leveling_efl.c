@@ -134,6 +134,61 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+// Physical sectors still to be erased for the current backing_store_erase_sector_start() request
+static flash_sector_t erase_next_sector;
+static flash_sector_t erase_end_sector;
+
+bool backing_store_erase_sector_start(uint32_t address) {
+    const flash_offset_t start = base_offset + address;
+    const flash_offset_t end   = start + (WEAR_LEVELING_SECTOR_SIZE);
+
+    // Sector sizes vary across the flash, so erase whichever sectors make up the requested range. The range has to
+    // start and end on sector boundaries, otherwise data outside of it would be erased as well.
+    bool found = false;
+    for (int i = 0; i < sector_count; ++i) {
+        flash_offset_t offset = flashGetSectorOffset(flash, first_sector + i);
+        if (offset < start || offset >= end) {
+            continue;
+        }
+        if ((!found && offset != start) || offset + flashGetSectorSize(flash, first_sector + i) > end) {
+            return false;
+        }
+        if (!found) {
+            erase_next_sector = first_sector + i;
+        }
+        erase_end_sector = first_sector + i + 1;
+        found            = true;
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Kick off the first sector erase, the rest are started as each one completes
+    bs_dprintf("Erase sector %08lX\n", (unsigned long)address);
+    flash_error_t status = flashStartEraseSector(flash, erase_next_sector++);
+    return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+}
+
+bool backing_store_erase_sector_poll(bool *done) {
+    uint32_t      wait_time;
+    flash_error_t status = flashQueryErase(flash, &wait_time);
+    *done                = false;
+    if (status == FLASH_BUSY_ERASING) {
+        return true;
+    }
+    if (status != FLASH_NO_ERROR) {
+        return false;
+    }
+    if (erase_next_sector < erase_end_sector) {
+        status = flashStartEraseSector(flash, erase_next_sector++);
+        return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+    }
+    *done = true;
+    return true;
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
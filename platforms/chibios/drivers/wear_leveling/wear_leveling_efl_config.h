@@ -52,5 +52,9 @@
 
 // 1kB logical EEPROM
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
@@ -190,6 +190,24 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+// Code executes from the same flash, so the erase completes before returning and has finished by the time it is polled.
+bool backing_store_erase_sector_start(uint32_t address) {
+    // Each bank sector has to map onto whole flash sectors.
+    STATIC_ASSERT((WEAR_LEVELING_SECTOR_SIZE) % (FLASH_SECTOR_SIZE) == 0, "WEAR_LEVELING_SECTOR_SIZE must be a multiple of FLASH_SECTOR_SIZE");
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + address, (WEAR_LEVELING_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    return true;
+}
+
+bool backing_store_erase_sector_poll(bool *done) {
+    *done = true;
+    return true;
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
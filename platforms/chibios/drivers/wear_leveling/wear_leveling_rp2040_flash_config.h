@@ -18,9 +18,18 @@
 
 // 32kB logical EEPROM
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
-#    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 4)
+#    else
+#        define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    endif
 #endif // WEAR_LEVELING_LOGICAL_SIZE
 
+// Background consolidation erases one flash sector at a time
+#if defined(WEAR_LEVELING_ASYNC_CONSOLIDATION) && !defined(WEAR_LEVELING_SECTOR_SIZE)
+#    define WEAR_LEVELING_SECTOR_SIZE (FLASH_SECTOR_SIZE)
+#endif // WEAR_LEVELING_SECTOR_SIZE
+
 // Define how much flash space we have (defaults to lib/pico-sdk/src/boards/include/boards/***)
 #ifndef WEAR_LEVELING_RP2040_FLASH_SIZE
 #    define WEAR_LEVELING_RP2040_FLASH_SIZE (PICO_FLASH_SIZE_BYTES)
@@ -0,0 +1,42 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+#include "matrix_wakeup.h"
+
+#if PAL_USE_CALLBACKS == TRUE
+static thread_reference_t wakeup_thread = NULL;
+
+static void matrix_wakeup_callback(void *arg) {
+    (void)arg;
+    chSysLockFromISR();
+    chThdResumeI(&wakeup_thread, MSG_OK);
+    chSysUnlockFromISR();
+}
+
+void matrix_wakeup_arm_pin(pin_t pin) {
+    palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pin, matrix_wakeup_callback, NULL);
+}
+
+void matrix_wakeup_disarm_pin(pin_t pin) {
+    palDisableLineEvent(pin);
+}
+
+void matrix_wakeup_wait(uint16_t timeout_ms) {
+    // Suspends the main thread, letting the idle thread sleep the core until the pin event or the timeout.
+    chSysLock();
+    chThdSuspendTimeoutS(&wakeup_thread, TIME_MS2I(timeout_ms));
+    chSysUnlock();
+}
+#else
+// Without PAL callbacks there are no pin events, the timeout alone bounds the wakeup latency.
+void matrix_wakeup_arm_pin(pin_t pin) {}
+
+void matrix_wakeup_disarm_pin(pin_t pin) {}
+
+void matrix_wakeup_wait(uint16_t timeout_ms) {
+    chThdSleepMilliseconds(timeout_ms);
+}
+#endif
@@ -0,0 +1,23 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "gpio.h"
+
+/**
+ * \brief Arms a wakeup interrupt on a matrix input pin, triggered on any edge.
+ */
+void matrix_wakeup_arm_pin(pin_t pin);
+
+/**
+ * \brief Disarms a wakeup interrupt previously armed with matrix_wakeup_arm_pin().
+ */
+void matrix_wakeup_disarm_pin(pin_t pin);
+
+/**
+ * \brief Puts the MCU to sleep until an armed pin changes, or for at most `timeout_ms`.
+ *
+ * Platforms without pin interrupts sleep until the next timer interrupt, returning after `timeout_ms`.
+ */
+void matrix_wakeup_wait(uint16_t timeout_ms);
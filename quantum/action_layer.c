@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -335,11 +336,11 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+/** \brief Layer switch get layer uncached
  *
- * Gets the layer based on key info
+ * Walks the layer stack top-down to find the first non-transparent layer for the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static uint8_t layer_switch_get_layer_uncached(keypos_t key) {
 #ifndef NO_ACTION_LAYER
     action_t action;
     action.code = ACTION_TRANSPARENT;
@@ -361,6 +362,59 @@ uint8_t layer_switch_get_layer(keypos_t key) {
 #endif
 }
 
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief layer lookup cache
+ *
+ * Effective layer of each matrix position for the layer stack in `layer_lookup_cache_state`.
+ * Entries are resolved lazily on first lookup, `LAYER_LOOKUP_CACHE_INVALID` marks an unresolved entry.
+ */
+#    define LAYER_LOOKUP_CACHE_INVALID 0xFF
+
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_lookup_cache_state = 0;
+static bool          layer_lookup_cache_valid = false;
+
+/** \brief Layer lookup cache invalidate
+ *
+ * Drops all resolved entries. Must be called whenever the keymap contents change.
+ */
+void layer_lookup_cache_invalidate(void) {
+    layer_lookup_cache_valid = false;
+}
+
+/** \brief Layer lookup cache get
+ *
+ * Returns the cached layer for the key, resolving it first if required
+ */
+static uint8_t layer_lookup_cache_get(keypos_t key) {
+    const layer_state_t layers = layer_state | default_layer_state;
+    if (!layer_lookup_cache_valid || layers != layer_lookup_cache_state) {
+        memset(layer_lookup_cache, LAYER_LOOKUP_CACHE_INVALID, sizeof(layer_lookup_cache));
+        layer_lookup_cache_state = layers;
+        layer_lookup_cache_valid = true;
+    }
+
+    uint8_t *entry = &layer_lookup_cache[key.row][key.col];
+    if (*entry == LAYER_LOOKUP_CACHE_INVALID) {
+        *entry = layer_switch_get_layer_uncached(key);
+    }
+    return *entry;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return layer_lookup_cache_get(key);
+    }
+#endif
+    return layer_switch_get_layer_uncached(key);
+}
+
 /** \brief Layer switch get layer
  *
  * Gets action code based on key position
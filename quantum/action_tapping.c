@@ -169,6 +169,25 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Reports when the pending tapping key settles, see keyboard_next_deadline().
+ */
+bool action_tapping_next_deadline(uint32_t *deadline) {
+    if (IS_NOEVENT(tapping_key.event) && waiting_buffer_head == waiting_buffer_tail) {
+        return false;
+    }
+
+    uint16_t remaining = 0;
+    if (IS_EVENT(tapping_key.event)) {
+        const uint16_t elapsed = timer_elapsed(tapping_key.event.time);
+        const uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+        if (elapsed < term) {
+            remaining = term - elapsed;
+        }
+    }
+    *deadline = timer_read32() + remaining;
+    return true;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
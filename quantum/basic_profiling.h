@@ -25,11 +25,15 @@
 #    define TIMESTAMP_GETTER TCNT0
 #elif defined(PROTOCOL_CHIBIOS)
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
-#else
+#elif !defined(PROFILER_ENABLE)
 #    error Unknown protocol in use
 #endif
 
-#ifndef CONSOLE_ENABLE
+#if defined(PROFILER_ENABLE)
+// Feed the hot-path profiler instead, which keeps full statistics per call site.
+#    include "profiler.h"
+#    define PROFILE_CALL_NAMED(count, name, call) PROFILER_CALL_NAMED(name, call)
+#elif !defined(CONSOLE_ENABLE)
 // Can't do anything if we don't have console output enabled.
 #    define PROFILE_CALL_NAMED(count, name, call) \
         do {                                      \
@@ -62,6 +66,6 @@
             }                                                                                                             \
         } while (0)
 
-#endif // CONSOLE_ENABLE
+#endif // PROFILER_ENABLE / CONSOLE_ENABLE
 
 #define PROFILE_CALL(count, call) PROFILE_CALL_NAMED(count, #call, call)
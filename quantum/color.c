@@ -108,3 +108,56 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+// Component order for each hue region, as 2 bit indices into {v, p, q, t}
+#define HSV_ORDER(r, g, b) ((r) | ((g) << 2) | ((b) << 4))
+enum { HSV_V, HSV_P, HSV_Q, HSV_T };
+
+static const uint8_t hsv_region_order[7] = {
+    HSV_ORDER(HSV_V, HSV_T, HSV_P), HSV_ORDER(HSV_Q, HSV_V, HSV_P), HSV_ORDER(HSV_P, HSV_V, HSV_T), HSV_ORDER(HSV_P, HSV_Q, HSV_V), HSV_ORDER(HSV_T, HSV_P, HSV_V), HSV_ORDER(HSV_V, HSV_P, HSV_Q), HSV_ORDER(HSV_V, HSV_T, HSV_P),
+};
+
+// Same arithmetic as hsv_to_rgb_impl(), with the division and the region switch
+// replaced by comparisons and a table lookup, leaving no data dependent jumps.
+static void hsv_to_rgb_batch_impl(const hsv_t *hsv, rgb_t *rgb, uint8_t count, bool use_cie) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t h = hsv[i].h;
+        uint8_t s = hsv[i].s;
+        uint8_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#endif
+
+        // h * 6 / 255
+        uint8_t region    = (h >= 43) + (h >= 85) + (h >= 128) + (h >= 170) + (h >= 213) + (h >= 255);
+        uint8_t remainder = (h * 2 - region * 85) * 3;
+
+        uint8_t c[4];
+        c[HSV_V] = v;
+        c[HSV_P] = (v * (255 - s)) >> 8;
+        c[HSV_Q] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        c[HSV_T] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+        if (s == 0) {
+            c[HSV_P] = c[HSV_Q] = c[HSV_T] = v;
+        }
+
+        uint8_t order = hsv_region_order[region];
+        rgb[i].r      = c[order & 3];
+        rgb[i].g      = c[(order >> 2) & 3];
+        rgb[i].b      = c[(order >> 4) & 3];
+    }
+}
+
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
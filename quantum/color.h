@@ -95,3 +95,13 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+/**
+ * \brief Converts `count` colors at once, with output identical to hsv_to_rgb().
+ */
+void hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count);
+
+/**
+ * \brief Converts `count` colors at once, with output identical to hsv_to_rgb_nocie().
+ */
+void hsv_to_rgb_batch_nocie(const hsv_t *hsv, rgb_t *rgb, uint8_t count);
@@ -0,0 +1,203 @@
+/*
+Copyright 2026 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm with bit-sliced counters, behaving like sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+Instead of one 8-bit counter per key, each row keeps DEBOUNCE_PLANES words where
+word n holds bit n of the counters of all columns. Counting down every column of
+a row is then a ripple subtraction over the planes, a few bitwise operations per
+plane regardless of the number of columns. Rows without any running counter are
+tracked in a bitmask and skipped entirely.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <stdlib.h>
+
+#ifdef PROTOCOL_CHIBIOS
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with this debounce algorithm.
+#    endif
+#endif
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Number of bits needed to hold a counter value of up to DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_PLANES 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_PLANES 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_PLANES 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_PLANES 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_PLANES 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_PLANES 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_PLANES 7
+#else
+#    define DEBOUNCE_PLANES 8
+#endif
+
+#if DEBOUNCE > 0
+static matrix_row_t *debounce_planes;
+static uint8_t      *active_rows;
+static fast_timer_t  last_time;
+static bool          counters_need_update;
+static bool          cooked_changed;
+
+#    define ROW_IS_ACTIVE(row) (active_rows[(row) / 8] & (1 << ((row) % 8)))
+#    define ROW_SET_ACTIVE(row) (active_rows[(row) / 8] |= (1 << ((row) % 8)))
+#    define ROW_CLEAR_ACTIVE(row) (active_rows[(row) / 8] &= ~(1 << ((row) % 8)))
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_planes = (matrix_row_t *)calloc(num_rows * DEBOUNCE_PLANES, sizeof(matrix_row_t));
+    active_rows     = (uint8_t *)calloc((num_rows + 7) / 8, sizeof(uint8_t));
+}
+
+void debounce_free(void) {
+    free(debounce_planes);
+    debounce_planes = NULL;
+    free(active_rows);
+    active_rows = NULL;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        // No counter exceeds DEBOUNCE, so this expires the same counters while fitting in the planes
+        if (elapsed_time > DEBOUNCE) {
+            elapsed_time = DEBOUNCE;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint16_t row_group = 0; row_group < num_rows; row_group += 8) {
+        if (!active_rows[row_group / 8]) {
+            continue;
+        }
+        for (uint8_t row = row_group; row < num_rows && row < row_group + 8; row++) {
+            if (!ROW_IS_ACTIVE(row)) {
+                continue;
+            }
+
+            // Subtract elapsed_time from the counters of all columns at once
+            matrix_row_t *planes  = &debounce_planes[row * DEBOUNCE_PLANES];
+            matrix_row_t  running = 0;
+            matrix_row_t  nonzero = 0;
+            matrix_row_t  borrow  = 0;
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                matrix_row_t counter = planes[plane];
+                matrix_row_t elapsed = (elapsed_time & (1 << plane)) ? ~(matrix_row_t)0 : 0;
+                matrix_row_t diff    = counter ^ elapsed ^ borrow;
+
+                borrow = (~counter & elapsed) | (~(counter ^ elapsed) & borrow);
+                running |= counter;
+                nonzero |= diff;
+                planes[plane] = diff;
+            }
+
+            // Counters that reached or went past zero have expired
+            matrix_row_t expired = running & (borrow | ~nonzero);
+            matrix_row_t pending = running & ~expired;
+            for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+                planes[plane] &= pending;
+            }
+
+            if (expired) {
+                matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+                cooked_changed |= cooked[row] ^ cooked_next;
+                cooked[row] = cooked_next;
+            }
+
+            if (pending) {
+                counters_need_update = true;
+            } else {
+                ROW_CLEAR_ACTIVE(row);
+            }
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        if (!delta && !ROW_IS_ACTIVE(row)) {
+            continue;
+        }
+
+        matrix_row_t *planes  = &debounce_planes[row * DEBOUNCE_PLANES];
+        matrix_row_t  running = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            running |= planes[plane];
+        }
+
+        // Keys that changed keep their running counter or start a new one, all other counters are stopped
+        matrix_row_t keep  = delta & running;
+        matrix_row_t start = delta & ~running;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            planes[plane] = (planes[plane] & keep) | ((DEBOUNCE & (1 << plane)) ? start : 0);
+        }
+
+        if (delta) {
+            ROW_SET_ACTIVE(row);
+            counters_need_update = true;
+        } else {
+            ROW_CLEAR_ACTIVE(row);
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -39,6 +39,11 @@ debounce_sym_defer_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_defer_pr.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_defer_pr_tests.cpp
 
+debounce_sym_defer_pk_sliced_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_defer_pk_sliced_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_sliced.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_sliced_tests.cpp
+
 debounce_sym_eager_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
@@ -9,34 +9,110 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+#if MAX_DEFERRED_EXECUTORS > 255
+#    error MAX_DEFERRED_EXECUTORS must not exceed 255
+#endif
+
 //------------------------------------
 // Helpers
 //
+// Each table is a binary min-heap of the pending executions, ordered by trigger time, so the task only has to check the
+// first one to know whether anything is due. Heap positions [0, heap_count) hold the pending executions, and the
+// remaining positions hold the free entries, in the order they'll be handed out. Positions are stored relative to the
+// entry's own index, so that a zero-initialised table is a valid empty heap.
+//
 
-static deferred_token current_token = 0;
+static inline uint8_t heap_count(deferred_executor_t *table) {
+    return table[0].heap_count;
+}
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
-    }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+static inline uint8_t heap_entry(deferred_executor_t *table, uint8_t position) {
+    return table[position].heap_entry ^ position;
+}
+
+static inline uint8_t heap_position(deferred_executor_t *table, uint8_t index) {
+    return table[index].heap_index ^ index;
+}
+
+static inline void heap_place(deferred_executor_t *table, uint8_t position, uint8_t index) {
+    table[position].heap_entry = index ^ position;
+    table[index].heap_index    = position ^ index;
+}
+
+static inline void heap_swap(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    uint8_t entry_a = heap_entry(table, a);
+    heap_place(table, a, heap_entry(table, b));
+    heap_place(table, b, entry_a);
+}
+
+static inline bool heap_earlier(deferred_executor_t *table, uint8_t a, uint8_t b) {
+    return ((int32_t)TIMER_DIFF_32(table[heap_entry(table, a)].trigger_time, table[heap_entry(table, b)].trigger_time)) < 0;
+}
+
+static void heap_sift_up(deferred_executor_t *table, uint8_t position) {
+    while (position > 0) {
+        uint8_t parent = (position - 1) / 2;
+        if (!heap_earlier(table, position, parent)) {
+            break;
         }
+        heap_swap(table, position, parent);
+        position = parent;
     }
-    return true;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift_down(deferred_executor_t *table, uint8_t position) {
+    uint8_t count = heap_count(table);
+    while (true) {
+        uint16_t earliest = position;
+        uint16_t left     = 2 * position + 1;
+        uint16_t right    = left + 1;
+        if (left < count && heap_earlier(table, left, earliest)) {
+            earliest = left;
+        }
+        if (right < count && heap_earlier(table, right, earliest)) {
+            earliest = right;
+        }
+        if (earliest == position) {
+            break;
         }
+        heap_swap(table, position, earliest);
+        position = earliest;
+    }
+}
+
+static inline void heap_update(deferred_executor_t *table, uint8_t index) {
+    uint8_t position = heap_position(table, index);
+    heap_sift_up(table, position);
+    heap_sift_down(table, heap_position(table, index));
+}
+
+static void heap_remove(deferred_executor_t *table, uint8_t index) {
+    // Move the entry to the start of the free entries, and restore the order of the one that took its place
+    uint8_t position = heap_position(table, index);
+    uint8_t last     = --table[0].heap_count;
+    heap_swap(table, position, last);
+    if (position < last) {
+        heap_update(table, heap_entry(table, position));
+    }
+}
+
+static void heap_rebuild(deferred_executor_t *table) {
+    for (uint8_t position = heap_count(table) / 2; position > 0; --position) {
+        heap_sift_down(table, position - 1);
     }
-    return current_token;
+}
+
+static inline void clear_entry(deferred_executor_t *entry) {
+    // The token is kept, so the next token handed out for this entry differs from it
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+}
+
+static inline deferred_executor_t *find_entry(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    // Tokens of an entry only differ by multiples of the table size
+    deferred_executor_t *entry = &table[(token - 1) % table_count];
+    return (entry->callback != NULL && entry->token == token) ? entry : NULL;
 }
 
 //------------------------------------
@@ -45,31 +121,32 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > UINT8_MAX || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // Claim the first free entry, if any are available
+    uint8_t count = heap_count(table);
+    if (count >= table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+    uint8_t              index = heap_entry(table, count);
+    deferred_executor_t *entry = &table[index];
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Cycle through the tokens of the entry, so a token that's been cancelled doesn't refer to the next execution
+    deferred_token token = index + 1;
+    if (entry->token != INVALID_DEFERRED_TOKEN && entry->token + table_count <= UINT8_MAX) {
+        token = entry->token + table_count;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    entry->token        = token;
+    entry->trigger_time = timer_read32() + delay_ms;
+    entry->callback     = callback;
+    entry->cb_arg       = cb_arg;
+    table[0].heap_count = count + 1;
+    heap_sift_up(table, count);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +156,15 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_update(table, entry - table);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +174,15 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    deferred_executor_t *entry = find_entry(table, table_count, token);
+    if (!entry) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    clear_entry(entry);
+    heap_remove(table, entry - table);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,18 +192,23 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
+        // Nothing to do until the earliest execution is due
+        if (heap_count(table) == 0 || ((int32_t)TIMER_DIFF_32(table[heap_entry(table, 0)].trigger_time, now)) > 0) {
+            return;
+        }
+
         // Run through each of the executors
         for (int i = 0; i < table_count; ++i) {
             deferred_executor_t *entry      = &table[i];
             deferred_token       curr_token = entry->token;
 
             // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
+            if (entry->callback != NULL && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
                 // Invoke the callback and work work out if we should be requeued
                 uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
 
                 // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
+                if (entry->callback == NULL || entry->token != curr_token) {
                     continue;
                 }
 
@@ -146,16 +221,26 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                     entry->trigger_time += delay_ms;
                 } else {
                     // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    clear_entry(entry);
+                    heap_remove(table, i);
                 }
             }
         }
+
+        // Trigger times were updated in place, so restore the heap order once all of the callbacks have run. This
+        // keeps each executor to a single invocation per pass, even if it's fallen behind.
+        heap_rebuild(table);
     }
 }
 
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || heap_count(table) == 0) {
+        return false;
+    }
+    *trigger_time = table[heap_entry(table, 0)].trigger_time;
+    return true;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -175,3 +260,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
@@ -15,11 +15,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
+#include "util.h"
 #include "nvm_dynamic_keymap.h"
 
 #ifdef ENCODER_ENABLE
@@ -32,16 +36,105 @@
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_CACHE
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS > DYNAMIC_KEYMAP_LAYER_COUNT
+#        error "DYNAMIC_KEYMAP_CACHE_LAYERS must not exceed DYNAMIC_KEYMAP_LAYER_COUNT"
+#    endif
+
+#    define KEYMAP_CACHE_KEYS (DYNAMIC_KEYMAP_CACHE_LAYERS * MATRIX_ROWS * MATRIX_COLS)
+
+// RAM copy of the first DYNAMIC_KEYMAP_CACHE_LAYERS layers. Keys changed since the last
+// flush are marked in keymap_cache_dirty and written to NVM once writes have settled.
+static uint16_t keymap_cache[KEYMAP_CACHE_KEYS];
+static uint8_t  keymap_cache_dirty[(KEYMAP_CACHE_KEYS + 7) / 8];
+static bool     keymap_cache_loaded  = false;
+static bool     keymap_cache_pending = false;
+static uint32_t keymap_cache_write_time;
+
+static inline uint16_t keymap_cache_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return ((uint16_t)layer * MATRIX_ROWS + row) * MATRIX_COLS + column;
+}
+
+static void keymap_cache_load(void) {
+    if (keymap_cache_loaded) {
+        return;
+    }
+
+    // Read the big endian NVM layout in one go, then convert in place
+    uint8_t *bytes = (uint8_t *)keymap_cache;
+    nvm_dynamic_keymap_read_buffer(0, sizeof(keymap_cache), bytes);
+    for (uint16_t i = 0; i < KEYMAP_CACHE_KEYS; i++) {
+        uint16_t keycode = (bytes[i * 2] << 8) | bytes[i * 2 + 1];
+        keymap_cache[i]  = keycode;
+    }
+    keymap_cache_loaded = true;
+}
+
+static void keymap_cache_set(uint16_t index, uint16_t keycode) {
+    if (keymap_cache[index] != keycode) {
+        keymap_cache[index] = keycode;
+        keymap_cache_dirty[index / 8] |= 1 << (index % 8);
+        keymap_cache_pending = true;
+    }
+    keymap_cache_write_time = timer_read32();
+}
+
+void dynamic_keymap_cache_init(void) {
+    keymap_cache_load();
+}
+
+void dynamic_keymap_cache_flush(void) {
+    if (!keymap_cache_pending) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < KEYMAP_CACHE_KEYS; i++) {
+        if (keymap_cache_dirty[i / 8] & (1 << (i % 8))) {
+            nvm_dynamic_keymap_update_keycode(i / (MATRIX_ROWS * MATRIX_COLS), (i / MATRIX_COLS) % MATRIX_ROWS, i % MATRIX_COLS, keymap_cache[i]);
+        }
+    }
+    memset(keymap_cache_dirty, 0, sizeof(keymap_cache_dirty));
+    keymap_cache_pending = false;
+}
+
+void dynamic_keymap_cache_task(void) {
+    if (keymap_cache_pending && timer_elapsed32(keymap_cache_write_time) >= DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY) {
+        dynamic_keymap_cache_flush();
+    }
+}
+
+bool dynamic_keymap_cache_is_dirty(void) {
+    return keymap_cache_pending;
+}
+#endif // DYNAMIC_KEYMAP_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_CACHE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYERS && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        keymap_cache_load();
+        return keymap_cache[keymap_cache_index(layer, row, column)];
+    }
+#endif // DYNAMIC_KEYMAP_CACHE
     return nvm_dynamic_keymap_read_keycode(layer, row, column);
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
-    nvm_dynamic_keymap_update_keycode(layer, row, column, keycode);
+#ifdef DYNAMIC_KEYMAP_CACHE
+    if (layer < DYNAMIC_KEYMAP_CACHE_LAYERS && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        keymap_cache_load();
+        keymap_cache_set(keymap_cache_index(layer, row, column), keycode);
+    } else
+#endif // DYNAMIC_KEYMAP_CACHE
+    {
+        nvm_dynamic_keymap_update_keycode(layer, row, column, keycode);
+    }
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_invalidate();
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -58,6 +151,13 @@ void dynamic_keymap_reset(void) {
     // Erase the keymaps, if necessary.
     nvm_dynamic_keymap_erase();
 
+#ifdef DYNAMIC_KEYMAP_CACHE
+    // Every cached key is about to be set, write them all back regardless of what the cache held.
+    keymap_cache_loaded  = true;
+    keymap_cache_pending = true;
+    memset(keymap_cache_dirty, 0xFF, sizeof(keymap_cache_dirty));
+#endif // DYNAMIC_KEYMAP_CACHE
+
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
         for (int row = 0; row < MATRIX_ROWS; row++) {
@@ -72,14 +172,149 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+
+#ifdef DYNAMIC_KEYMAP_CACHE
+    // Callers such as eeconfig_init_via() rely on the keymap being stored when this returns.
+    dynamic_keymap_cache_flush();
+#endif // DYNAMIC_KEYMAP_CACHE
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+#ifdef DYNAMIC_KEYMAP_CACHE
+    // Serve the cached layers from RAM, anything beyond them from NVM
+    keymap_cache_load();
+    uint16_t cached = offset < sizeof(keymap_cache) ? MIN(size, sizeof(keymap_cache) - offset) : 0;
+    for (uint16_t i = 0; i < cached; i++) {
+        uint16_t keycode = keymap_cache[(offset + i) / 2];
+        data[i]          = ((offset + i) % 2) ? (keycode & 0xFF) : (keycode >> 8);
+    }
+    offset += cached;
+    size -= cached;
+    data += cached;
+#endif // DYNAMIC_KEYMAP_CACHE
     nvm_dynamic_keymap_read_buffer(offset, size, data);
 }
 
+// With repeat set, data holds a single keycode which is written to every keycode in the range.
+static void dynamic_keymap_update_buffer(uint16_t offset, uint16_t size, uint8_t *data, bool repeat) {
+#ifdef DYNAMIC_KEYMAP_CACHE
+    keymap_cache_load();
+    uint16_t cached = offset < sizeof(keymap_cache) ? MIN(size, sizeof(keymap_cache) - offset) : 0;
+    for (uint16_t i = 0; i < cached; i++) {
+        uint16_t index   = (offset + i) / 2;
+        uint16_t keycode = keymap_cache[index];
+        uint8_t  value   = data[repeat ? i % 2 : i];
+        if ((offset + i) % 2) {
+            keycode = (keycode & 0xFF00) | value;
+        } else {
+            keycode = (keycode & 0x00FF) | (value << 8);
+        }
+        keymap_cache_set(index, keycode);
+    }
+    offset += cached;
+    size -= cached;
+    if (!repeat) {
+        data += cached;
+    }
+#endif // DYNAMIC_KEYMAP_CACHE
+    if (!repeat) {
+        nvm_dynamic_keymap_update_buffer(offset, size, data);
+        return;
+    }
+    for (uint16_t i = 0; i < size; i += 2) {
+        nvm_dynamic_keymap_update_buffer(offset + i, MIN(2, size - i), data);
+    }
+}
+
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    nvm_dynamic_keymap_update_buffer(offset, size, data);
+    dynamic_keymap_update_buffer(offset, size, data, false);
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_invalidate();
+#endif
+}
+
+// Keycodes read ahead at a time while encoding
+#define DYNAMIC_KEYMAP_RLE_WINDOW 16
+
+typedef struct {
+    uint16_t offset; // Buffer offset of the first keycode held
+    uint8_t  count;  // Number of keycodes held
+    uint8_t  data[DYNAMIC_KEYMAP_RLE_WINDOW * 2];
+} dynamic_keymap_rle_window_t;
+
+// Offsets only ever move forwards while encoding, so each keycode is read from the keymap once.
+static uint16_t dynamic_keymap_rle_window_keycode(dynamic_keymap_rle_window_t *window, uint16_t offset, uint16_t end) {
+    if (offset < window->offset || offset >= window->offset + window->count * 2) {
+        window->offset = offset;
+        window->count  = MIN(DYNAMIC_KEYMAP_RLE_WINDOW, (end - offset) / 2);
+        dynamic_keymap_get_buffer(offset, window->count * 2, window->data);
+    }
+    uint8_t *data = &window->data[offset - window->offset];
+    return (data[0] << 8) | data[1];
+}
+
+uint8_t dynamic_keymap_get_buffer_rle(uint16_t *offset, uint16_t end, uint8_t *data, uint8_t size) {
+    dynamic_keymap_rle_window_t window = {.count = 0};
+    uint8_t                     length = 0;
+    // Every token needs room for its header and at least one keycode
+    while (*offset < end && length + 3 <= size) {
+        uint16_t keycode = dynamic_keymap_rle_window_keycode(&window, *offset, end);
+        uint8_t  count   = 1;
+        while (count < DYNAMIC_KEYMAP_RLE_MAX_COUNT && *offset + count * 2 < end && dynamic_keymap_rle_window_keycode(&window, *offset + count * 2, end) == keycode) {
+            count++;
+        }
+
+        if (count > 1) {
+            data[length++] = DYNAMIC_KEYMAP_RLE_RUN | count;
+            data[length++] = keycode >> 8;
+            data[length++] = keycode & 0xFF;
+            *offset += count * 2;
+            continue;
+        }
+
+        // Literal keycodes, up to the start of the next run
+        uint8_t *header = &data[length++];
+        count           = 0;
+        while (*offset < end && length + 2 <= size && count < DYNAMIC_KEYMAP_RLE_MAX_COUNT) {
+            uint16_t next = *offset + 2 < end ? dynamic_keymap_rle_window_keycode(&window, *offset + 2, end) : ~keycode;
+            if (count > 0 && next == keycode) {
+                break;
+            }
+            data[length++] = keycode >> 8;
+            data[length++] = keycode & 0xFF;
+            *offset += 2;
+            count++;
+            keycode = next;
+        }
+        *header = count;
+    }
+    return length;
+}
+
+bool dynamic_keymap_set_buffer_rle(uint16_t *offset, uint16_t end, uint8_t *data, uint8_t size) {
+    bool    valid    = true;
+    uint8_t position = 0;
+    while (position < size) {
+        uint8_t token = data[position++];
+        uint8_t count = token & DYNAMIC_KEYMAP_RLE_MAX_COUNT;
+        bool    run   = token & DYNAMIC_KEYMAP_RLE_RUN;
+        uint8_t bytes = run ? 2 : count * 2;
+        if (count == 0 || *offset + count * 2 > end || position + bytes > size) {
+            valid = false;
+            break;
+        }
+
+        // Each token is written as a single block, runs without expanding the keycode into a buffer
+        dynamic_keymap_update_buffer(*offset, count * 2, &data[position], run);
+        *offset += count * 2;
+        position += bytes;
+    }
+
+    // Invalidate once for everything written, rather than for every token
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_invalidate();
+#endif
+    return valid;
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
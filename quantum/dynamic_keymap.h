@@ -26,6 +26,17 @@
 #    define DYNAMIC_KEYMAP_MACRO_COUNT 16
 #endif
 
+#ifdef DYNAMIC_KEYMAP_CACHE
+// Number of layers, starting from layer 0, kept in RAM. Each costs MATRIX_ROWS * MATRIX_COLS * 2 bytes.
+#    ifndef DYNAMIC_KEYMAP_CACHE_LAYERS
+#        define DYNAMIC_KEYMAP_CACHE_LAYERS DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+// Milliseconds without further changes before changed keys are written to NVM
+#    ifndef DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY 1000
+#    endif
+#endif // DYNAMIC_KEYMAP_CACHE
+
 uint8_t  dynamic_keymap_get_layer_count(void);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
 void     dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
@@ -34,6 +45,16 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+#ifdef DYNAMIC_KEYMAP_CACHE
+// Loads the cached layers from NVM, called from keyboard_init()
+void dynamic_keymap_cache_init(void);
+// Writes changed keys to NVM once DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY has passed since the last change
+void dynamic_keymap_cache_task(void);
+// Writes changed keys to NVM now
+void dynamic_keymap_cache_flush(void);
+// Whether there are changed keys not yet written to NVM
+bool dynamic_keymap_cache_is_dirty(void);
+#endif // DYNAMIC_KEYMAP_CACHE
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -45,6 +66,16 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// Run-length encoded variants of the above, working on whole keycodes, so offset and end must be even.
+// A token byte 0b0nnnnnnn is followed by n keycodes, 0b1nnnnnnn by one keycode repeated n times.
+// get encodes the keycodes from *offset up to end into at most size bytes, and returns the number of bytes used.
+// set decodes size bytes, and returns false if the data is malformed or goes past end.
+// Both advance *offset past the keycodes processed.
+#define DYNAMIC_KEYMAP_RLE_RUN 0x80
+#define DYNAMIC_KEYMAP_RLE_MAX_COUNT 0x7F
+uint8_t dynamic_keymap_get_buffer_rle(uint16_t *offset, uint16_t end, uint8_t *data, uint8_t size);
+bool    dynamic_keymap_set_buffer_rle(uint16_t *offset, uint16_t end, uint8_t *data, uint8_t size);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -62,6 +63,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef HAPTIC_ENABLE
 #    include "haptic.h"
 #endif
@@ -149,6 +153,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef CONNECTION_ENABLE
 #    include "connection.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && (defined(WEAR_LEVELING_DEFERRED_COMMIT) || defined(WEAR_LEVELING_ASYNC_CONSOLIDATION))
+#    include "wear_leveling.h"
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifndef NO_ACTION_TAPPING
+#    include "action_tapping.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -200,27 +213,40 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 // Only enable this if console is enabled to print to
 #if defined(DEBUG_MATRIX_SCAN_RATE)
-static uint32_t matrix_timer           = 0;
-static uint32_t matrix_scan_count      = 0;
-static uint32_t last_matrix_scan_count = 0;
+static uint32_t matrix_timer                = 0;
+static uint32_t matrix_scan_count           = 0;
+static uint32_t last_matrix_scan_count      = 0;
+static uint32_t matrix_idle_scan_count      = 0;
+static uint32_t last_matrix_idle_scan_count = 0;
 
 void matrix_scan_perf_task(void) {
     matrix_scan_count++;
+    if (matrix_is_idle()) {
+        matrix_idle_scan_count++;
+    }
 
     uint32_t timer_now = timer_read32();
     if (TIMER_DIFF_32(timer_now, matrix_timer) >= 1000) {
-#    if defined(CONSOLE_ENABLE)
+#    if defined(CONSOLE_ENABLE) && defined(MATRIX_IDLE_WAKEUP_ENABLE)
+        dprintf("matrix scan frequency: %lu (idle: %lu)\n", matrix_scan_count, matrix_idle_scan_count);
+#    elif defined(CONSOLE_ENABLE)
         dprintf("matrix scan frequency: %lu\n", matrix_scan_count);
 #    endif
-        last_matrix_scan_count = matrix_scan_count;
-        matrix_timer           = timer_now;
-        matrix_scan_count      = 0;
+        last_matrix_scan_count      = matrix_scan_count;
+        last_matrix_idle_scan_count = matrix_idle_scan_count;
+        matrix_timer                = timer_now;
+        matrix_scan_count           = 0;
+        matrix_idle_scan_count      = 0;
     }
 }
 
 uint32_t get_matrix_scan_rate(void) {
     return last_matrix_scan_count;
 }
+
+uint32_t get_matrix_idle_scan_rate(void) {
+    return last_matrix_idle_scan_count;
+}
 #else
 #    define matrix_scan_perf_task()
 #endif
@@ -351,6 +377,14 @@ __attribute__((weak)) bool matrix_can_read(void) {
     return true;
 }
 
+/** \brief matrix_is_idle
+ *
+ * Implemented by matrices that sleep until a key press while idle, see MATRIX_IDLE_WAKEUP_ENABLE.
+ */
+__attribute__((weak)) bool matrix_is_idle(void) {
+    return false;
+}
+
 /** \brief keyboard_setup
  *
  * FIXME: needs doc
@@ -457,6 +491,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef PROFILER_ENABLE
+    profiler_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -468,6 +505,12 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_CACHE)
+    dynamic_keymap_cache_init();
+#endif
+#if defined(COMBO_ENABLE) && defined(COMBO_KEYCODE_INDEX)
+    combo_keycode_index_rebuild();
+#endif
 #ifdef CONNECTION_ENABLE
     connection_init();
 #endif
@@ -625,7 +668,7 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    PROFILER_CALL_NAMED("action_exec", action_exec(MAKE_KEYEVENT(row, col, key_pressed)));
                 }
 
                 switch_events(row, col, key_pressed);
@@ -719,13 +762,17 @@ void quantum_task(void) {
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+    PROFILER_START(keyboard_task);
+
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed        = false;
+    PROFILER_CALL_NAMED("matrix_task", matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    PROFILER_CALL(quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
@@ -739,7 +786,7 @@ void keyboard_task(void) {
     led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    PROFILER_CALL(rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -809,7 +856,78 @@ void keyboard_task(void) {
 
     led_task();
 
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_CACHE)
+    dynamic_keymap_cache_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && (defined(WEAR_LEVELING_DEFERRED_COMMIT) || defined(WEAR_LEVELING_ASYNC_CONSOLIDATION))
+    wear_leveling_task();
+#endif
+
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+    PROFILER_STOP(keyboard_task);
+}
+
+/** \brief Keeps the earliest of two deadlines, both in the time-space of timer_read32(). */
+__attribute__((unused)) static void keyboard_merge_deadline(uint32_t candidate, bool *has_deadline, uint32_t *deadline) {
+    if (!*has_deadline || timer_expired32(*deadline, candidate)) {
+        *deadline     = candidate;
+        *has_deadline = true;
+    }
+}
+
+/** \brief Retrieves the earliest time a timer driven subsystem needs keyboard_task() to run, even without any input.
+ *
+ * Lets the matrix sleep for longer while idle, see MATRIX_IDLE_WAKEUP_TICKLESS.
+ */
+bool keyboard_next_deadline(uint32_t *deadline) {
+    bool                             has_deadline = false;
+    __attribute__((unused)) uint32_t candidate;
+
+#ifndef NO_ACTION_TAPPING
+    if (action_tapping_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (tap_dance_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef COMBO_ENABLE
+    if (combo_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef LEADER_ENABLE
+    if (leader_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef LED_MATRIX_ENABLE
+    if (led_matrix_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+#ifdef DEFERRED_EXEC_ENABLE
+    if (deferred_exec_next_deadline(&candidate)) {
+        keyboard_merge_deadline(candidate, &has_deadline, deadline);
+    }
+#endif
+
+    return has_deadline;
 }
@@ -138,6 +138,9 @@ uint32_t last_pointing_device_activity_elapsed(void); // Number of milliseconds
 void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timestamp, uint32_t pointing_device_timestamp); // Set the timestamps of the last matrix and encoder activity
 
 uint32_t get_matrix_scan_rate(void);
+uint32_t get_matrix_idle_scan_rate(void);
+
+bool keyboard_next_deadline(uint32_t *deadline); // Earliest time, as per timer_read32(), at which a timer driven subsystem needs keyboard_task() to run; false if none is pending
 
 #ifdef __cplusplus
 }
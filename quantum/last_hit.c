@@ -0,0 +1,68 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "last_hit.h"
+#include <string.h>
+
+static inline uint8_t last_hit_slot(const last_hit_buffer_t *buffer, uint8_t offset) {
+    uint16_t slot = buffer->head + offset;
+    return slot >= LED_HITS_TO_REMEMBER ? slot - LED_HITS_TO_REMEMBER : slot;
+}
+
+void last_hit_clear(last_hit_buffer_t *buffer) {
+    buffer->head       = 0;
+    buffer->hits.count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        buffer->hits.tick[i] = UINT16_MAX;
+    }
+}
+
+bool last_hit_push(last_hit_buffer_t *buffer, uint8_t index, uint8_t x, uint8_t y, uint16_t *dropped_tick) {
+    bool dropped = false;
+    if (buffer->hits.count == LED_HITS_TO_REMEMBER) {
+        if (dropped_tick) {
+            *dropped_tick = buffer->hits.tick[buffer->head];
+        }
+        buffer->head = last_hit_slot(buffer, 1);
+        buffer->hits.count--;
+        dropped = true;
+    }
+
+    uint8_t slot             = last_hit_slot(buffer, buffer->hits.count);
+    buffer->hits.x[slot]     = x;
+    buffer->hits.y[slot]     = y;
+    buffer->hits.index[slot] = index;
+    buffer->hits.tick[slot]  = 0;
+    buffer->hits.count++;
+    return dropped;
+}
+
+uint8_t last_hit_advance(last_hit_buffer_t *buffer, uint32_t delta) {
+    // Every tick grows by the same amount, so the oldest hits always expire first.
+    uint8_t dropped = 0;
+    while (buffer->hits.count && delta > (uint32_t)(UINT16_MAX - buffer->hits.tick[buffer->head])) {
+        buffer->head = last_hit_slot(buffer, 1);
+        buffer->hits.count--;
+        dropped++;
+    }
+
+    for (uint8_t i = 0; i < buffer->hits.count; ++i) {
+        buffer->hits.tick[last_hit_slot(buffer, i)] += delta;
+    }
+    return dropped;
+}
+
+void last_hit_snapshot(const last_hit_buffer_t *buffer, last_hit_t *tracker, uint8_t *led_hit, uint8_t led_count) {
+    memset(led_hit, LAST_HIT_NONE, led_count);
+    tracker->count = buffer->hits.count;
+    for (uint8_t i = 0; i < buffer->hits.count; ++i) {
+        uint8_t slot      = last_hit_slot(buffer, i);
+        tracker->x[i]     = buffer->hits.x[slot];
+        tracker->y[i]     = buffer->hits.y[slot];
+        tracker->index[i] = buffer->hits.index[slot];
+        tracker->tick[i]  = buffer->hits.tick[slot];
+        if (tracker->index[i] < led_count) {
+            led_hit[tracker->index[i]] = i;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/*
+    Key hit tracking shared by the LED and RGB matrix reactive effects.
+
+    Key events are recorded in a ring buffer, so recording a hit and expiring old ones
+    never moves the other entries. Once per frame the buffer is copied into a last_hit_t,
+    which lists the hits from oldest to newest for the effects, together with the
+    position of the most recent hit of each LED.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "compiler_support.h"
+#include "util.h"
+
+#ifndef LED_HITS_TO_REMEMBER
+#    define LED_HITS_TO_REMEMBER 8
+#endif // LED_HITS_TO_REMEMBER
+
+#if LED_HITS_TO_REMEMBER > 255
+#    error "LED_HITS_TO_REMEMBER must not exceed 255"
+#endif
+
+// No hit recorded for an LED
+#define LAST_HIT_NONE 0xFF
+
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+typedef struct last_hit_buffer_t {
+    uint8_t    head; // slot of the oldest hit
+    last_hit_t hits; // ring storage, `hits.count` entries starting at `head`
+} last_hit_buffer_t;
+
+/**
+ * \brief Forgets all hits.
+ */
+void last_hit_clear(last_hit_buffer_t *buffer);
+
+/**
+ * \brief Records a hit with a tick of 0, replacing the oldest hit if the buffer is full.
+ *
+ * \return true if a hit was replaced, its tick is then stored in `dropped_tick` unless it is NULL.
+ */
+bool last_hit_push(last_hit_buffer_t *buffer, uint8_t index, uint8_t x, uint8_t y, uint16_t *dropped_tick);
+
+/**
+ * \brief Adds `delta` to the tick of every hit, dropping hits whose tick would overflow.
+ *
+ * \return the number of hits dropped.
+ */
+uint8_t last_hit_advance(last_hit_buffer_t *buffer, uint32_t delta);
+
+/**
+ * \brief Copies the hits into `tracker` from oldest to newest.
+ *
+ * `led_hit` receives, for each of the `led_count` LEDs, the position of its most recent
+ * hit in `tracker`, or LAST_HIT_NONE.
+ */
+void last_hit_snapshot(const last_hit_buffer_t *buffer, last_hit_t *tracker, uint8_t *led_hit, uint8_t led_count);
@@ -79,6 +79,21 @@ bool leader_sequence_timed_out(void) {
 #endif
 }
 
+bool leader_next_deadline(uint32_t *deadline) {
+    if (!leader_sequence_active()) {
+        return false;
+    }
+#if defined(LEADER_NO_TIMEOUT)
+    if (leader_sequence_size == 0) {
+        return false;
+    }
+#endif
+
+    uint16_t elapsed = timer_elapsed(leader_time);
+    *deadline        = timer_read32() + (elapsed > LEADER_TIMEOUT ? 0 : LEADER_TIMEOUT + 1 - elapsed);
+    return true;
+}
+
 void leader_reset_timer(void) {
     leader_time = timer_read();
 }
@@ -65,6 +65,14 @@ bool leader_sequence_add(uint16_t keycode);
  */
 bool leader_sequence_timed_out(void);
 
+/**
+ * Retrieve the time at which the leader sequence times out.
+ *
+ * \param deadline[out] when `leader_task()` ends the sequence -- equivalent time-space as `timer_read32()`
+ * \return `true` if a sequence is active and can time out, otherwise `false` and `deadline` is left untouched
+ */
+bool leader_next_deadline(uint32_t *deadline);
+
 /**
  * Reset the leader sequence timer.
  */
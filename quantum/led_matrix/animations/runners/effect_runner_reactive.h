@@ -11,12 +11,10 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
-        // Reverse search to find most recent key hit
-        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
-            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
-                tick = g_last_hit_tracker.tick[j];
-                break;
-            }
+        // Most recent key hit
+        uint8_t hit = g_last_hit_led[i];
+        if (hit != LAST_HIT_NONE && g_last_hit_tracker.tick[hit] < tick) {
+            tick = g_last_hit_tracker.tick[hit];
         }
 
         uint16_t offset = scale16by8(tick, led_matrix_eeconfig.speed);
@@ -68,6 +68,7 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // LED_MATRIX_FRAMEBUFFER_EFFECTS
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
+uint8_t    g_last_hit_led[LED_MATRIX_LED_COUNT];
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
@@ -80,7 +81,7 @@ static led_task_states led_task_state    = SYNCING;
 // double buffers
 static uint32_t led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+static last_hit_buffer_t last_hit_buffer;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // split led matrix
@@ -188,21 +189,8 @@ void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        last_hit_push(&last_hit_buffer, led[i], g_led_config.point[led[i]].x, g_led_config.point[led[i]].y, NULL);
     }
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
@@ -230,14 +218,7 @@ static void led_task_timers(void) {
 
     // Update double buffer last hit timers
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
+    last_hit_advance(&last_hit_buffer, deltaTime);
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 }
 
@@ -254,7 +235,7 @@ static void led_task_start(void) {
     // update double buffers
     g_led_timer = led_timer_buffer;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    last_hit_snapshot(&last_hit_buffer, &g_last_hit_tracker, g_last_hit_led, LED_MATRIX_LED_COUNT);
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -335,9 +316,7 @@ static void led_task_flush(uint8_t effect) {
     led_task_state = SYNCING;
 }
 
-void led_matrix_task(void) {
-    led_task_timers();
-
+static uint8_t led_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -346,7 +325,13 @@ void led_matrix_task(void) {
 #endif // LED_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+    return suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+}
+
+void led_matrix_task(void) {
+    led_task_timers();
+
+    uint8_t effect = led_task_effect();
 
     switch (led_task_state) {
         case STARTING:
@@ -370,6 +355,22 @@ void led_matrix_task(void) {
     }
 }
 
+bool led_matrix_next_deadline(uint32_t *deadline) {
+    if (led_task_state != SYNCING) {
+        // a frame is being rendered across several calls to led_matrix_task()
+        *deadline = timer_read32();
+        return true;
+    }
+    if (!led_task_effect() && !led_last_effect && led_last_enable == led_matrix_eeconfig.enable) {
+        // the blank frame has been flushed, nothing changes until the matrix is turned back on
+        return false;
+    }
+
+    uint32_t elapsed = sync_timer_elapsed32(g_led_timer);
+    *deadline        = timer_read32() + (elapsed >= LED_MATRIX_LED_FLUSH_LIMIT ? 0 : LED_MATRIX_LED_FLUSH_LIMIT - elapsed);
+    return true;
+}
+
 __attribute__((weak)) bool led_matrix_indicators_modules(void) {
     return true;
 }
@@ -442,15 +443,8 @@ void led_matrix_init(void) {
     led_matrix_driver.init();
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+    last_hit_clear(&last_hit_buffer);
+    last_hit_snapshot(&last_hit_buffer, &g_last_hit_tracker, g_last_hit_led, LED_MATRIX_LED_COUNT);
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
     eeconfig_init_led_matrix();
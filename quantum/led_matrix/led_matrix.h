@@ -135,6 +135,8 @@ void led_matrix_set_value_all(uint8_t value);
 void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void led_matrix_task(void);
+// Next time led_matrix_task() has a frame to render, see keyboard_next_deadline()
+bool led_matrix_next_deadline(uint32_t *deadline);
 
 // This runs after another backlight effect and replaces
 // values already set
@@ -202,6 +204,8 @@ extern uint32_t     g_led_timer;
 extern led_config_t g_led_config;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+// Position of the most recent hit of each LED in g_last_hit_tracker, or LAST_HIT_NONE
+extern uint8_t g_last_hit_led[LED_MATRIX_LED_COUNT];
 #endif
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
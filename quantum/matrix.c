@@ -51,6 +51,34 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+#ifdef MATRIX_IDLE_WAKEUP_ENABLE
+#    include "matrix_wakeup.h"
+#    include "timer.h"
+
+// How long the matrix has to be released before switching to interrupt wakeup, in milliseconds.
+#    ifndef MATRIX_IDLE_WAKEUP_DELAY
+#        define MATRIX_IDLE_WAKEUP_DELAY 50
+#    endif
+
+// Upper bound for a single sleep while idle, keeping the rest of keyboard_task() running.
+// Subsystems without a deadline of their own, such as encoders, are only serviced at this rate while idle.
+#    ifndef MATRIX_IDLE_WAKEUP_SLEEP
+#        define MATRIX_IDLE_WAKEUP_SLEEP 10
+#    endif
+
+#    ifdef SPLIT_KEYBOARD
+// Upper bound for a single sleep while idle on the split master, which has to keep polling the other half for key
+// presses as they can't wake it up.
+#        ifndef MATRIX_IDLE_WAKEUP_SPLIT_SLEEP
+#            define MATRIX_IDLE_WAKEUP_SPLIT_SLEEP 1
+#        endif
+#    endif
+
+#    if defined(MATRIX_IDLE_WAKEUP_TICKLESS) || defined(SPLIT_KEYBOARD)
+#        include "keyboard.h"
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -133,6 +161,39 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#    ifdef MATRIX_IDLE_WAKEUP_ENABLE
+static void matrix_idle_arm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (direct_pins[row][col] != NO_PIN) {
+                matrix_wakeup_arm_pin(direct_pins[row][col]);
+            }
+        }
+    }
+}
+
+static void matrix_idle_disarm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (direct_pins[row][col] != NO_PIN) {
+                matrix_wakeup_disarm_pin(direct_pins[row][col]);
+            }
+        }
+    }
+}
+
+static bool matrix_idle_key_pressed(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!readMatrixPin(direct_pins[row][col])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+#    endif // MATRIX_IDLE_WAKEUP_ENABLE
+
 #elif defined(DIODE_DIRECTION)
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
@@ -198,6 +259,39 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_IDLE_WAKEUP_ENABLE
+// All rows are driven at once, so that any key press pulls its column and fires the wakeup.
+static void matrix_idle_arm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            matrix_wakeup_arm_pin(col_pins[col]);
+        }
+    }
+}
+
+static void matrix_idle_disarm(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            matrix_wakeup_disarm_pin(col_pins[col]);
+        }
+    }
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+}
+
+static bool matrix_idle_key_pressed(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (!readMatrixPin(col_pins[col])) {
+            return true;
+        }
+    }
+    return false;
+}
+#            endif // MATRIX_IDLE_WAKEUP_ENABLE
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -262,6 +356,39 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
 }
 
+#            ifdef MATRIX_IDLE_WAKEUP_ENABLE
+// All columns are driven at once, so that any key press pulls its row and fires the wakeup.
+static void matrix_idle_arm(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (row_pins[row] != NO_PIN) {
+            matrix_wakeup_arm_pin(row_pins[row]);
+        }
+    }
+}
+
+static void matrix_idle_disarm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (row_pins[row] != NO_PIN) {
+            matrix_wakeup_disarm_pin(row_pins[row]);
+        }
+    }
+    unselect_cols();
+    matrix_output_unselect_delay(0, true);
+}
+
+static bool matrix_idle_key_pressed(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (!readMatrixPin(row_pins[row])) {
+            return true;
+        }
+    }
+    return false;
+}
+#            endif // MATRIX_IDLE_WAKEUP_ENABLE
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -320,9 +447,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static inline void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -335,6 +460,121 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+#ifdef MATRIX_IDLE_WAKEUP_ENABLE
+static bool     matrix_idle       = false;
+static uint16_t matrix_idle_timer = 0;
+
+bool matrix_is_idle(void) {
+    return matrix_idle;
+}
+
+/**
+ * \brief How long the next sleep while idle may last, in milliseconds.
+ */
+static uint16_t matrix_idle_sleep_time(void) {
+#    ifdef SPLIT_KEYBOARD
+    if (is_keyboard_master()) {
+        return MATRIX_IDLE_WAKEUP_SPLIT_SLEEP;
+    }
+#    endif
+#    ifdef MATRIX_IDLE_WAKEUP_TICKLESS
+    // Wake up in time for the earliest timer instead of polling for it
+    uint32_t deadline;
+    if (keyboard_next_deadline(&deadline)) {
+        uint32_t now = timer_read32();
+        if (timer_expired32(now, deadline)) {
+            return 0;
+        }
+        if (deadline - now < MATRIX_IDLE_WAKEUP_SLEEP) {
+            return deadline - now;
+        }
+    }
+#    endif
+    return MATRIX_IDLE_WAKEUP_SLEEP;
+}
+
+/**
+ * \brief Sleeps while the matrix is idle.
+ *
+ * \return true if no key has been pressed since going idle, in which case scanning can be skipped.
+ */
+static bool matrix_idle_task(void) {
+    if (!matrix_idle) {
+        return false;
+    }
+
+    uint16_t sleep_time = matrix_idle_sleep_time();
+    if (sleep_time) {
+        matrix_wakeup_wait(sleep_time);
+    }
+    if (!matrix_idle_key_pressed()) {
+        return true;
+    }
+
+    // Back to full scanning until the matrix is released for long enough again
+    matrix_idle_disarm();
+    matrix_idle       = false;
+    matrix_idle_timer = timer_read();
+    return false;
+}
+
+static bool matrix_idle_keys_held(void) {
+#    ifdef SPLIT_KEYBOARD
+    const matrix_row_t *debounced = matrix + thisHand;
+#    else
+    const matrix_row_t *debounced = matrix;
+#    endif
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] || debounced[row]) {
+            return true;
+        }
+    }
+
+#    ifdef SPLIT_KEYBOARD
+    // Keys held on the other half keep the master scanning as well
+    if (is_keyboard_master()) {
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            if (matrix[thatHand + row]) {
+                return true;
+            }
+        }
+    }
+#    endif
+    return false;
+}
+
+static void matrix_idle_update(void) {
+    if (matrix_idle_keys_held()) {
+        if (matrix_idle) {
+            // Only a key on the other half gets here while idle, as local key presses are handled on wakeup
+            matrix_idle_disarm();
+            matrix_idle = false;
+        }
+        matrix_idle_timer = timer_read();
+        return;
+    }
+
+    if (!matrix_idle && timer_elapsed(matrix_idle_timer) >= MATRIX_IDLE_WAKEUP_DELAY) {
+        matrix_idle_arm();
+        matrix_idle = true;
+    }
+}
+#endif // MATRIX_IDLE_WAKEUP_ENABLE
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_IDLE_WAKEUP_ENABLE
+    // While idle the matrix is known to be released, so it is only read again once a key wakes it up
+    if (!matrix_idle_task()) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -345,5 +585,9 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+#ifdef MATRIX_IDLE_WAKEUP_ENABLE
+    matrix_idle_update();
+#endif
     return (uint8_t)changed;
 }
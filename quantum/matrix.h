@@ -53,6 +53,8 @@ void matrix_init(void);
 uint8_t matrix_scan(void);
 /* whether matrix scanning operations should be executed */
 bool matrix_can_read(void);
+/* whether the matrix is idle and waiting for a key press to wake it up, see MATRIX_IDLE_WAKEUP_ENABLE */
+bool matrix_is_idle(void);
 /* whether a switch is on */
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
@@ -1,9 +1,11 @@
 // Copyright 2024 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
 #include "compiler_support.h"
 #include "keycodes.h"
 #include "eeprom.h"
+#include "util.h"
 #include "dynamic_keymap.h"
 #include "nvm_dynamic_keymap.h"
 #include "nvm_eeprom_eeconfig_internal.h"
@@ -124,17 +126,12 @@ void nvm_dynamic_keymap_update_encoder(uint8_t layer, uint8_t encoder_id, bool c
 
 void nvm_dynamic_keymap_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
     uint32_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint32_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
+    uint32_t stored                     = offset < dynamic_keymap_eeprom_size ? MIN(size, dynamic_keymap_eeprom_size - offset) : 0;
+    // One block read, so external EEPROMs can use a single sequential bus transfer
+    if (stored > 0) {
+        eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), stored);
     }
+    memset(data + stored, 0x00, size - stored);
 }
 
 void nvm_dynamic_keymap_update_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
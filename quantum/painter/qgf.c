@@ -64,7 +64,7 @@ bool qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette,
     return true;
 }
 
-bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay) {
+bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_delta_rects, painter_compression_t *compression_scheme, uint16_t *delay) {
     // Decode the format
     qgf_parse_format(frame_descriptor->format, bpp, has_palette, is_panel_native);
 
@@ -72,6 +72,9 @@ bool qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp,
     if (is_delta) {
         *is_delta = (frame_descriptor->flags & QGF_FRAME_FLAG_DELTA) == QGF_FRAME_FLAG_DELTA;
     }
+    if (is_delta_rects) {
+        *is_delta_rects = (frame_descriptor->flags & (QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_DELTA_RECTS)) == (QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_DELTA_RECTS);
+    }
     if (compression_scheme) {
         *compression_scheme = frame_descriptor->compression_scheme;
     }
@@ -177,7 +180,7 @@ void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     qp_stream_setpos(stream, offset);
 }
 
-bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta) {
+bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_delta_rects) {
     // Seek to the correct location
     qgf_seek_to_frame_descriptor(stream, frame_number);
 
@@ -193,7 +196,7 @@ bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, u
         return false;
     }
 
-    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, NULL, NULL);
+    return qgf_parse_frame_descriptor(&frame_descriptor, bpp, has_palette, is_panel_native, is_delta, is_delta_rects, NULL, NULL);
 }
 
 bool qgf_validate_palette_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t bpp) {
@@ -231,6 +234,28 @@ bool qgf_validate_delta_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     return true;
 }
 
+bool qgf_validate_delta_rects_descriptor(qp_stream_t *stream, uint16_t frame_number) {
+    // Read the delta rectangles descriptor
+    qgf_delta_rects_v1_t delta_rects_descriptor;
+    if (qp_stream_read(&delta_rects_descriptor, sizeof(qgf_delta_rects_v1_t), 1, stream) != 1) {
+        qp_dprintf("Failed to read delta_rects_descriptor, expected length was not %d\n", (int)sizeof(qgf_delta_rects_v1_t));
+        return false;
+    }
+
+    // Make sure this block is valid, and contains a whole number of rectangles
+    if (!qgf_validate_block_header(&delta_rects_descriptor.header, QGF_FRAME_DELTA_RECTS_DESCRIPTOR_TYPEID, -1)) {
+        return false;
+    }
+    if (delta_rects_descriptor.header.length == 0 || (delta_rects_descriptor.header.length % sizeof(qgf_delta_rect_v1_t)) != 0) {
+        qp_dprintf("Failed to validate delta_rects_descriptor, length %d is not a non-zero multiple of %d\n", (int)delta_rects_descriptor.header.length, (int)sizeof(qgf_delta_rect_v1_t));
+        return false;
+    }
+
+    // Move forward in the stream to the next block
+    qp_stream_seek(stream, delta_rects_descriptor.header.length, SEEK_CUR);
+    return true;
+}
+
 bool qgf_validate_frame_data_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     // Read and validate the data block
     qgf_data_v1_t data_descriptor;
@@ -259,7 +284,8 @@ bool qgf_validate_stream(qp_stream_t *stream) {
         bool    has_palette     = false;
         bool    is_panel_native = false;
         bool    has_delta       = false;
-        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta)) {
+        bool    has_delta_rects = false;
+        if (!qgf_validate_frame_descriptor(stream, i, &bpp, &has_palette, &is_panel_native, &has_delta, &has_delta_rects)) {
             return false;
         }
 
@@ -268,8 +294,12 @@ bool qgf_validate_stream(qp_stream_t *stream) {
             return false;
         }
 
-        // If we've got a delta block, check it
-        if (has_delta && !qgf_validate_delta_descriptor(stream, i)) {
+        // If we've got a delta block, check it -- multiple rectangles replace the single delta rectangle
+        if (has_delta_rects) {
+            if (!qgf_validate_delta_rects_descriptor(stream, i)) {
+                return false;
+            }
+        } else if (has_delta && !qgf_validate_delta_descriptor(stream, i)) {
             return false;
         }
 
@@ -75,6 +75,7 @@ typedef struct QP_PACKED qgf_frame_v1_t {
 
 STATIC_ASSERT(sizeof(qgf_frame_v1_t) == (sizeof(qgf_block_header_v1_t) + 6), "qgf_frame_v1_t must be 11 bytes in v1 of QGF");
 
+#define QGF_FRAME_FLAG_DELTA_RECTS 0x04
 #define QGF_FRAME_FLAG_DELTA 0x02
 #define QGF_FRAME_FLAG_TRANSPARENT 0x01
 
@@ -113,6 +114,27 @@ typedef struct QP_PACKED qgf_delta_v1_t {
 
 STATIC_ASSERT(sizeof(qgf_delta_v1_t) == (sizeof(qgf_block_header_v1_t) + 8), "qgf_delta_v1_t must be 13 bytes in v1 of QGF");
 
+/////////////////////////////////////////
+// Frame delta rectangles descriptor
+
+#define QGF_FRAME_DELTA_RECTS_DESCRIPTOR_TYPEID 0x06
+
+typedef struct QP_PACKED qgf_delta_rect_v1_t {
+    uint16_t left;   // The left pixel location to draw the rectangle's pixel data
+    uint16_t top;    // The top pixel location to draw the rectangle's pixel data
+    uint16_t right;  // The right pixel location to draw the rectangle's pixel data
+    uint16_t bottom; // The bottom pixel location to draw the rectangle's pixel data
+} qgf_delta_rect_v1_t;
+
+STATIC_ASSERT(sizeof(qgf_delta_rect_v1_t) == 8, "qgf_delta_rect_v1_t must be 8 bytes in v1 of QGF");
+
+typedef struct QP_PACKED qgf_delta_rects_v1_t {
+    qgf_block_header_v1_t header;  // = { .type_id = 0x06, .neg_type_id = (~0x06), .length = (N * 8) }
+    qgf_delta_rect_v1_t   rect[0]; // '0' signifies that this struct is immediately followed by the rectangles
+} qgf_delta_rects_v1_t;
+
+STATIC_ASSERT(sizeof(qgf_delta_rects_v1_t) == sizeof(qgf_block_header_v1_t), "qgf_delta_rects_v1_t must only contain qgf_block_header_v1_t in v1 of QGF");
+
 /////////////////////////////////////////
 // Frame data descriptor
 
@@ -134,4 +156,4 @@ bool     qgf_validate_block_header(qgf_block_header_v1_t *desc, uint8_t expected
 bool     qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, uint16_t *image_height, uint16_t *frame_count, uint32_t *total_bytes);
 bool     qgf_parse_format(qp_image_format_t format, uint8_t *bpp, bool *has_palette, bool *is_panel_native);
 void     qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number);
-bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, painter_compression_t *compression_scheme, uint16_t *delay);
+bool     qgf_parse_frame_descriptor(qgf_frame_v1_t *frame_descriptor, uint8_t *bpp, bool *has_palette, bool *is_panel_native, bool *is_delta, bool *is_delta_rects, painter_compression_t *compression_scheme, uint16_t *delay);
@@ -56,6 +56,24 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of glyphs that \ref qp_drawtext and \ref qp_drawtext_recolor keep pre-rendered in the
+ *      display's native pixel format, so that redrawing the same text skips decoding the font. The least recently used
+ *      glyph is replaced once the cache is full. Each entry uses \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of
+ *      RAM. Defaults to 0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the size in bytes of each glyph cache entry. Glyphs whose native pixel data is larger than this
+ *      are always decoded from the font.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 512
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +90,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+/**
+ * @def This controls whether a second pixel data buffer is used, so that images and fonts can be decoded into one
+ *      buffer while the other one is still being transmitted by comms supporting asynchronous transfers, such as SPI
+ *      on ChibiOS. Doubles the RAM used by \ref QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE.
+ */
+#    define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER FALSE
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -488,6 +515,27 @@ int16_t qp_drawtext(painter_device_t device, uint16_t x, uint16_t y, painter_fon
  */
 int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_font_handle_t font, const char *str, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+/**
+ * Glyph cache statistics, as returned by \ref qp_get_glyph_cache_stats.
+ */
+typedef struct qp_glyph_cache_stats_t {
+    uint32_t hits;   // glyphs drawn from the cache
+    uint32_t misses; // glyphs decoded from the font
+} qp_glyph_cache_stats_t;
+
+/**
+ * Retrieves the number of glyph cache hits and misses since startup, or since the last call to
+ * \ref qp_reset_glyph_cache_stats. Both counters stay at zero if \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES is 0.
+ *
+ * @param stats[out] the statistics to fill in
+ */
+void qp_get_glyph_cache_stats(qp_glyph_cache_stats_t *stats);
+
+/**
+ * Resets the glyph cache hit and miss counters.
+ */
+void qp_reset_glyph_cache_stats(void);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Drivers
 
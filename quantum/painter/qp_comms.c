@@ -33,6 +33,7 @@ void qp_comms_stop(painter_device_t device) {
         return;
     }
 
+    qp_comms_fence(device);
     driver->comms_vtable->comms_stop(device);
 }
 
@@ -46,6 +47,33 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+uint32_t qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    // Comms without asynchronous support complete the transfer straight away
+    if (!driver->comms_vtable->comms_send_async) {
+        return driver->comms_vtable->comms_send(device, data, byte_count);
+    }
+
+    return driver->comms_vtable->comms_send_async(device, data, byte_count);
+}
+
+void qp_comms_fence(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_fence: fail (validation_ok == false)\n");
+        return;
+    }
+
+    if (driver->comms_vtable->comms_fence) {
+        driver->comms_vtable->comms_fence(device);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
@@ -9,8 +9,18 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
-// Global variable used for native pixel data streaming.
+// Global variable used for native pixel data streaming. When double buffered, points at the buffer currently being filled.
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+extern uint8_t *qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+
+// Sends the first native_pixel_count pixels of the pixdata buffer, which may still be in transit once this returns
+bool qp_internal_pixdata_transmit(painter_device_t device, uint32_t native_pixel_count);
+
+// Must be called before overwriting the pixdata buffer; swaps to the idle buffer or waits for the transfer to complete
+void qp_internal_pixdata_acquire(painter_device_t device);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -27,10 +37,13 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
-// Convert from input pixel data + palette to equivalent pixels
+// Number of pixels decoded at a time before they're handed to the output callback
+#define QP_INTERNAL_DECODE_SPAN_PIXELS 32
+
+// Convert from input pixel data + palette to equivalent pixels, output callbacks receive whole spans of pixels or bytes
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
-typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
-typedef bool (*qp_internal_byte_output_callback)(uint8_t byte, void* cb_arg);
+typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg);
+typedef bool (*qp_internal_byte_output_callback)(uint8_t* bytes, uint32_t count, void* cb_arg);
 bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg);
 bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg);
 bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
@@ -82,7 +95,7 @@ typedef struct qp_internal_pixel_output_state_t {
     uint32_t         max_pixels;
 } qp_internal_pixel_output_state_t;
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
+bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg);
 
 typedef struct qp_internal_byte_output_state_t {
     painter_device_t device;
@@ -90,7 +103,7 @@ typedef struct qp_internal_byte_output_state_t {
     uint32_t         max_bytes;
 } qp_internal_byte_output_state_t;
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
+bool qp_internal_byte_appender(uint8_t* bytes, uint32_t count, void* cb_arg);
 
 // Helper shared between image and font rendering, sends pixels to the display using:
 //     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
@@ -5,6 +5,7 @@
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
+#include <string.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Palette / Monochrome-format decoder
@@ -29,23 +30,59 @@ bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
     return true;
 }
 
+// Pulls the next span of bytes from the input, defined alongside the decoders below
+static uint32_t qp_internal_read_span(qp_internal_byte_input_callback input_callback, void* input_arg, uint8_t* bytes, uint32_t buffer_size, uint32_t max_bytes, bool* repeated);
+
 bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
     const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
     const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
     uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
+    uint8_t       indices[QP_INTERNAL_DECODE_SPAN_PIXELS];
     while (remaining_pixels > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
+        // Input bytes are read into the tail of the buffer so that each one can be expanded in place
+        uint32_t byte_limit = (remaining_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        uint8_t  max_bytes  = QP_INTERNAL_DECODE_SPAN_PIXELS / pixels_per_byte;
+        uint8_t* bytes      = &indices[QP_INTERNAL_DECODE_SPAN_PIXELS - max_bytes];
+        bool     repeated;
+        uint32_t byte_count = qp_internal_read_span(input_callback, input_arg, bytes, max_bytes, byte_limit, &repeated);
+        if (byte_count == 0) {
             return false;
         }
-        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
-        for (uint8_t q = 0; q < loop_pixels; ++q) {
-            if (!output_callback(palette, byteval & pixel_bitmask, output_arg)) {
-                return false;
+
+        uint32_t span_pixels = QP_MIN(remaining_pixels, byte_count * pixels_per_byte);
+        remaining_pixels -= span_pixels;
+
+        if (repeated) {
+            // Expand the repeated byte once and keep sending the same span until the run is complete
+            uint8_t byteval = bytes[0];
+            for (uint8_t i = 0; i < QP_INTERNAL_DECODE_SPAN_PIXELS; ++i) {
+                indices[i] = (byteval >> ((i % pixels_per_byte) * bits_per_pixel)) & pixel_bitmask;
+            }
+            while (span_pixels > 0) {
+                uint8_t loop_pixels = QP_MIN(span_pixels, QP_INTERNAL_DECODE_SPAN_PIXELS);
+                if (!output_callback(palette, indices, loop_pixels, output_arg)) {
+                    return false;
+                }
+                span_pixels -= loop_pixels;
+            }
+            continue;
+        }
+
+        // 8bpp bytes are already palette indices, everything else is unpacked low bits first
+        uint8_t* span = bytes;
+        if (pixels_per_byte > 1) {
+            span = indices;
+            for (uint8_t b = 0, p = 0; p < span_pixels; ++b) {
+                uint8_t byteval = bytes[b];
+                for (uint8_t q = 0; q < pixels_per_byte && p < span_pixels; ++q) {
+                    indices[p++] = byteval & pixel_bitmask;
+                    byteval >>= bits_per_pixel;
+                }
             }
-            byteval >>= bits_per_pixel;
         }
-        remaining_pixels -= loop_pixels;
+        if (!output_callback(palette, span, span_pixels, output_arg)) {
+            return false;
+        }
     }
     return true;
 }
@@ -68,15 +105,25 @@ bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, u
 
 bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg) {
     uint32_t remaining_bytes = byte_count;
+    uint8_t  bytes[QP_INTERNAL_DECODE_SPAN_PIXELS];
     while (remaining_bytes > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
+        bool     repeated;
+        uint32_t span_bytes = qp_internal_read_span(input_callback, input_arg, bytes, sizeof(bytes), remaining_bytes, &repeated);
+        if (span_bytes == 0) {
             return false;
         }
-        if (!output_callback(byteval, output_arg)) {
-            return false;
+        remaining_bytes -= span_bytes;
+
+        if (repeated) {
+            memset(bytes, bytes[0], sizeof(bytes));
+        }
+        while (span_bytes > 0) {
+            uint8_t loop_bytes = QP_MIN(span_bytes, sizeof(bytes));
+            if (!output_callback(bytes, loop_bytes, output_arg)) {
+                return false;
+            }
+            span_bytes -= loop_bytes;
         }
-        remaining_bytes -= 1;
     }
     return true;
 }
@@ -90,21 +137,25 @@ static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
     return state->curr;
 }
 
+static inline void qp_drawimage_byte_rle_read_marker(qp_internal_byte_input_state_t* state) {
+    uint8_t c = qp_stream_get(state->src_stream);
+    if (c >= 128) {
+        state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
+        state->rle.remain = c - 127;
+    } else {
+        state->rle.mode   = REPEATING_RUN; // repeated run
+        state->rle.remain = c;
+    }
+
+    state->curr = qp_stream_get(state->src_stream);
+}
+
 static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
 
     // Work out if we're parsing the initial marker byte
     if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
-        }
-
-        state->curr = qp_stream_get(state->src_stream);
+        qp_drawimage_byte_rle_read_marker(state);
     }
 
     // Work out which byte we're returning
@@ -126,40 +177,96 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
-    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
-    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+// Pulls the next span of bytes, at most max_bytes. The built-in decoders return up to buffer_size bytes at a time, and
+// a repeated RLE run is returned as a single byte with `repeated` set so that it can be filled rather than decoded.
+// Any other input callback is pulled one byte at a time. Returns the number of bytes in the span, or 0 on failure.
+static uint32_t qp_internal_read_span(qp_internal_byte_input_callback input_callback, void* input_arg, uint8_t* bytes, uint32_t buffer_size, uint32_t max_bytes, bool* repeated) {
+    qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)input_arg;
+    uint32_t                        count = QP_MIN(buffer_size, max_bytes);
+    *repeated                             = false;
 
-    if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos++, 1, &index)) {
-        return false;
+    if (input_callback == qp_drawimage_byte_uncompressed_decoder) {
+        return qp_stream_read(bytes, 1, count, state->src_stream) == count ? count : 0;
+    }
+
+    if (input_callback == qp_drawimage_byte_rle_decoder) {
+        if (state->rle.mode == MARKER_BYTE) {
+            qp_drawimage_byte_rle_read_marker(state);
+        }
+
+        bytes[0] = state->curr;
+        if (state->rle.mode == REPEATING_RUN) {
+            *repeated = true;
+            count     = QP_MIN(state->rle.remain, max_bytes);
+        } else {
+            // The first byte of the run has already been queued up, the rest come straight from the stream
+            count = QP_MIN(state->rle.remain, count);
+            if (count > 1 && qp_stream_read(&bytes[1], 1, count - 1, state->src_stream) != count - 1) {
+                return 0;
+            }
+        }
+
+        state->rle.remain -= count;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
+        } else if (state->rle.mode == NON_REPEATING_RUN) {
+            state->curr = qp_stream_get(state->src_stream);
+        }
+        return count;
     }
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+    int16_t byteval = input_callback(input_arg);
+    if (byteval < 0) {
+        return 0;
+    }
+    bytes[0] = byteval;
+    return 1;
+}
+
+bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t* indices, uint32_t count, void* cb_arg) {
+    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
+    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+
+    while (count > 0) {
+        // Append as much of the span as fits in the buffer in one go
+        uint32_t loop_pixels = QP_MIN(count, state->max_pixels - state->pixel_write_pos);
+        if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos, loop_pixels, indices)) {
             return false;
         }
-        state->pixel_write_pos = 0;
+        state->pixel_write_pos += loop_pixels;
+        indices += loop_pixels;
+        count -= loop_pixels;
+
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (state->pixel_write_pos == state->max_pixels) {
+            if (!qp_internal_pixdata_transmit(state->device, state->pixel_write_pos)) {
+                return false;
+            }
+            state->pixel_write_pos = 0;
+            qp_internal_pixdata_acquire(state->device);
+        }
     }
 
     return true;
 }
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
+bool qp_internal_byte_appender(uint8_t* bytes, uint32_t count, void* cb_arg) {
     qp_internal_byte_output_state_t* state  = (qp_internal_byte_output_state_t*)cb_arg;
     painter_driver_t*                driver = (painter_driver_t*)state->device;
 
-    if (!driver->driver_vtable->append_pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos++, byteval)) {
-        return false;
-    }
-
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!driver->driver_vtable->append_pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos++, bytes[i])) {
             return false;
         }
-        state->byte_write_pos = 0;
+
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (state->byte_write_pos == state->max_bytes) {
+            if (!qp_internal_pixdata_transmit(state->device, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+                return false;
+            }
+            state->byte_write_pos = 0;
+            qp_internal_pixdata_acquire(state->device);
+        }
     }
 
     return true;
@@ -171,6 +278,9 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 
     bool ret = false;
 
+    // The previous drawing operation may still be sending the buffer
+    qp_internal_pixdata_acquire(device);
+
     // Non-native pixel format
     if (bpp <= 8) {
         // Set up the output state
@@ -180,7 +290,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret &= qp_internal_pixdata_transmit(device, output_state.pixel_write_pos);
         }
     }
 
@@ -197,7 +307,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret &= qp_internal_pixdata_transmit(device, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
         }
     }
 
@@ -20,8 +20,15 @@ STATIC_ASSERT((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXD
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Buffers used for transmitting native pixel data to the downstream device. One is filled while the other is sent.
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+uint8_t                                       *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
+static const uint8_t                          *qp_internal_pixdata_in_flight     = NULL;
+#else
 // Buffer used for transmitting native pixel data to the downstream device.
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -42,10 +49,31 @@ uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device) {
     return ((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE * 8) / driver->native_bits_per_pixel);
 }
 
+// Sends the start of the global native pixel buffer, which may still be in transit once this returns
+bool qp_internal_pixdata_transmit(painter_device_t device, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    qp_internal_pixdata_in_flight = qp_internal_global_pixdata_buffer;
+#endif
+    return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+}
+
+// Makes the global native pixel buffer safe to overwrite
+void qp_internal_pixdata_acquire(painter_device_t device) {
+#if QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    // Only the most recently transmitted buffer can still be in transit, so the other one is free
+    if (qp_internal_global_pixdata_buffer == qp_internal_pixdata_in_flight) {
+        qp_internal_global_pixdata_buffer = (qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0]) ? qp_internal_pixdata_buffers[1] : qp_internal_pixdata_buffers[0];
+    }
+#else
+    qp_comms_fence(device);
+#endif
+}
+
 // qp_setpixel internal implementation, but accepts a buffer with pre-converted native pixel. Only the first pixel is used.
 bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y) {
     painter_driver_t *driver = (painter_driver_t *)device;
-    return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
+    return driver->driver_vtable->viewport(device, x, y, x, y) && qp_internal_pixdata_transmit(device, 1);
 }
 
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
@@ -53,6 +81,7 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
     painter_driver_t *driver            = (painter_driver_t *)device;
     uint32_t          pixels_in_pixdata = qp_internal_num_pixels_in_buffer(device);
     num_pixels                          = QP_MIN(pixels_in_pixdata, num_pixels);
+    qp_internal_pixdata_acquire(device);
 
     // Convert the color to native pixel format
     qp_pixel_t color = {.hsv888 = {.h = hue, .s = sat, .v = val}};
@@ -243,7 +272,7 @@ bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t left, ui
     driver->driver_vtable->viewport(device, l, t, r, b);
     while (remaining > 0) {
         uint32_t transmit = QP_MIN(remaining, pixels_in_pixdata);
-        if (!driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, transmit)) {
+        if (!qp_internal_pixdata_transmit(device, transmit)) {
             return false;
         }
         remaining -= transmit;
@@ -117,6 +117,9 @@ typedef struct qgf_frame_info_t {
     bool                  has_palette;
     bool                  is_panel_native;
     bool                  is_delta;
+    bool                  is_delta_rects;
+    uint32_t              rect_count;   // number of delta rectangles, if is_delta_rects
+    uint32_t              rects_offset; // stream position of the first delta rectangle, if is_delta_rects
     uint16_t              left;
     uint16_t              top;
     uint16_t              right;
@@ -144,7 +147,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Parse out the frame info
-    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->compression_scheme, &info->delay)) {
+    if (!qgf_parse_frame_descriptor(&frame_descriptor, &info->bpp, &info->has_palette, &info->is_panel_native, &info->is_delta, &info->is_delta_rects, &info->compression_scheme, &info->delay)) {
         return false;
     }
 
@@ -184,7 +187,18 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Handle delta if needed
-    if (info->is_delta) {
+    if (info->is_delta_rects) {
+        qgf_delta_rects_v1_t delta_rects_descriptor;
+        if (qp_stream_read(&delta_rects_descriptor, sizeof(qgf_delta_rects_v1_t), 1, &qgf_image->stream) != 1) {
+            qp_dprintf("Failed to read delta_rects_descriptor, expected length was not %d\n", (int)sizeof(qgf_delta_rects_v1_t));
+            return false;
+        }
+
+        // The rectangles are read back one at a time while rendering, skip over them for now
+        info->rect_count   = delta_rects_descriptor.header.length / sizeof(qgf_delta_rect_v1_t);
+        info->rects_offset = qp_stream_tell(&qgf_image->stream);
+        qp_stream_seek(&qgf_image->stream, delta_rects_descriptor.header.length, SEEK_CUR);
+    } else if (info->is_delta) {
         qgf_delta_v1_t delta_descriptor;
         if (qp_stream_read(&delta_descriptor, sizeof(qgf_delta_v1_t), 1, &qgf_image->stream) != 1) {
             qp_dprintf("Failed to read delta_descriptor, expected length was not %d\n", (int)sizeof(qgf_delta_v1_t));
@@ -208,6 +222,29 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     return true;
 }
 
+// Decodes the pixel data at the current stream position into the supplied area of the display
+static bool qp_drawimage_recolor_area(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b, qgf_image_handle_t *qgf_image, qgf_frame_info_t *frame_info) {
+    painter_driver_t *driver      = (painter_driver_t *)device;
+    uint32_t          pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
+
+    // Configure where we're going to be rendering to
+    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
+        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
+        return false;
+    }
+
+    // Set up the input state, each area's pixel data is compressed on its own
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
+    if (input_callback == NULL) {
+        qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
+        return false;
+    }
+
+    // Decode and stream pixels
+    return qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
+}
+
 static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, int frame_number, qgf_frame_info_t *frame_info, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
     qp_dprintf("qp_drawimage_recolor: entry\n");
     painter_driver_t *driver = (painter_driver_t *)device;
@@ -233,39 +270,28 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
-    uint16_t l, t, r, b;
-    if (frame_info->is_delta) {
-        l = x + frame_info->left;
-        t = y + frame_info->top;
-        r = x + frame_info->right;
-        b = y + frame_info->bottom;
+    bool ret;
+    if (frame_info->is_delta_rects) {
+        // Each rectangle's pixel data follows on from the previous one's in the data block
+        ret = true;
+        for (uint32_t i = 0; ret && i < frame_info->rect_count; ++i) {
+            uint32_t            data_pos = qp_stream_tell(&qgf_image->stream);
+            qgf_delta_rect_v1_t rect;
+            qp_stream_setpos(&qgf_image->stream, frame_info->rects_offset + i * sizeof(qgf_delta_rect_v1_t));
+            if (qp_stream_read(&rect, sizeof(qgf_delta_rect_v1_t), 1, &qgf_image->stream) != 1) {
+                qp_dprintf("qp_drawimage_recolor: fail (could not read delta rectangle %d)\n", (int)i);
+                ret = false;
+                break;
+            }
+            qp_stream_setpos(&qgf_image->stream, data_pos);
+            ret = qp_drawimage_recolor_area(device, x + rect.left, y + rect.top, x + rect.right, y + rect.bottom, qgf_image, frame_info);
+        }
+    } else if (frame_info->is_delta) {
+        ret = qp_drawimage_recolor_area(device, x + frame_info->left, y + frame_info->top, x + frame_info->right, y + frame_info->bottom, qgf_image, frame_info);
     } else {
-        l = x;
-        t = y;
-        r = x + image->width - 1;
-        b = y + image->height - 1;
-    }
-    uint32_t pixel_count = ((uint32_t)(r - l + 1)) * (b - t + 1);
-
-    // Configure where we're going to be rendering to
-    if (!driver->driver_vtable->viewport(device, l, t, r, b)) {
-        qp_dprintf("qp_drawimage_recolor: fail (could not set viewport)\n");
-        qp_comms_stop(device);
-        return false;
+        ret = qp_drawimage_recolor_area(device, x, y, x + image->width - 1, y + image->height - 1, qgf_image, frame_info);
     }
 
-    // Set up the input state
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
-    if (input_callback == NULL) {
-        qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
-    // Decode and stream pixels
-    bool ret = qp_internal_appender(device, frame_info->bpp, pixel_count, input_callback, &input_state);
-
     qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
     return ret;
@@ -36,6 +36,149 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+static qp_glyph_cache_stats_t glyph_cache_stats = {0};
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t   device; // NULL if the entry is unused
+    qff_font_handle_t *font;
+    uint32_t           code_point;
+    qp_pixel_t         fg_hsv888;
+    qp_pixel_t         bg_hsv888;
+    uint32_t           last_used;
+    uint8_t            width;
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t                  glyph_cache_entries[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+__attribute__((__aligned__(4))) static uint8_t glyph_cache_pixdata[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES][QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE];
+static uint32_t                                glyph_cache_clock = 0;
+
+static inline bool qp_glyph_cache_same_color(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache_entries[i];
+        if (entry->device == device && entry->font == qff_font && entry->code_point == code_point && qp_glyph_cache_same_color(entry->fg_hsv888, fg_hsv888) && qp_glyph_cache_same_color(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = ++glyph_cache_clock;
+            glyph_cache_stats.hits++;
+            return entry;
+        }
+    }
+    glyph_cache_stats.misses++;
+    return NULL;
+}
+
+// Frees up the least recently used entry
+static qp_glyph_cache_entry_t *qp_glyph_cache_evict(void) {
+    qp_glyph_cache_entry_t *oldest = &glyph_cache_entries[0];
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES && oldest->device != NULL; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache_entries[i];
+        if (entry->device == NULL || (glyph_cache_clock - entry->last_used) > (glyph_cache_clock - oldest->last_used)) {
+            oldest = entry;
+        }
+    }
+
+    // The pixel data may still be in transit to the display it was last drawn on
+    if (oldest->device != NULL) {
+        qp_comms_fence(oldest->device);
+        oldest->device = NULL;
+    }
+    return oldest;
+}
+
+static inline uint8_t *qp_glyph_cache_pixdata(qp_glyph_cache_entry_t *entry) {
+    return glyph_cache_pixdata[entry - glyph_cache_entries];
+}
+
+typedef struct qp_glyph_cache_fill_state_t {
+    painter_device_t device;
+    uint8_t         *buffer;
+    uint32_t         write_pos;
+} qp_glyph_cache_fill_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t *indices, uint32_t count, void *cb_arg) {
+    qp_glyph_cache_fill_state_t *state  = (qp_glyph_cache_fill_state_t *)cb_arg;
+    painter_driver_t            *driver = (painter_driver_t *)state->device;
+    bool                         ok     = driver->driver_vtable->append_pixels(state->device, state->buffer, palette, state->write_pos, count, indices);
+    state->write_pos += count;
+    return ok;
+}
+
+static bool qp_glyph_cache_byte_appender(uint8_t *bytes, uint32_t count, void *cb_arg) {
+    qp_glyph_cache_fill_state_t *state  = (qp_glyph_cache_fill_state_t *)cb_arg;
+    painter_driver_t            *driver = (painter_driver_t *)state->device;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!driver->driver_vtable->append_pixdata(state->device, state->buffer, state->write_pos++, bytes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Decodes the glyph at the current stream position into a cache entry, returns NULL if it can't be cached
+static qp_glyph_cache_entry_t *qp_glyph_cache_fill(painter_device_t device, qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint8_t width, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t *input_state) {
+    painter_driver_t *driver      = (painter_driver_t *)device;
+    uint32_t          pixel_count = ((uint32_t)width) * qff_font->base.line_height;
+    if ((pixel_count * driver->native_bits_per_pixel + 7) / 8 > QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE || (qff_font->bpp > 8 && qff_font->bpp != driver->native_bits_per_pixel)) {
+        return NULL;
+    }
+
+    qp_glyph_cache_entry_t     *entry = qp_glyph_cache_evict();
+    qp_glyph_cache_fill_state_t state = {.device = device, .buffer = qp_glyph_cache_pixdata(entry), .write_pos = 0};
+
+    bool ok;
+    if (qff_font->bpp <= 8) {
+        ok = qp_internal_decode_palette(device, pixel_count, qff_font->bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &state);
+    } else {
+        ok = qp_internal_send_bytes(device, pixel_count * qff_font->bpp / 8, input_callback, input_state, qp_glyph_cache_byte_appender, &state);
+    }
+    if (!ok) {
+        return NULL;
+    }
+
+    entry->device     = device;
+    entry->font       = qff_font;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = fg_hsv888;
+    entry->bg_hsv888  = bg_hsv888;
+    entry->width      = width;
+    entry->last_used  = ++glyph_cache_clock;
+    return entry;
+}
+
+static void qp_glyph_cache_invalidate_font(qff_font_handle_t *qff_font) {
+    for (uint16_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache_entries[i].font == qff_font && glyph_cache_entries[i].device != NULL) {
+            qp_comms_fence(glyph_cache_entries[i].device);
+            glyph_cache_entries[i].device = NULL;
+        }
+    }
+}
+
+#else // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+static inline void qp_glyph_cache_invalidate_font(qff_font_handle_t *qff_font) {}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_get_glyph_cache_stats
+
+void qp_get_glyph_cache_stats(qp_glyph_cache_stats_t *stats) {
+    *stats = glyph_cache_stats;
+}
+
+void qp_reset_glyph_cache_stats(void) {
+    glyph_cache_stats.hits   = 0;
+    glyph_cache_stats.misses = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -151,6 +294,9 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+    // Drop any cached glyphs, the handle may be reused for a different font
+    qp_glyph_cache_invalidate_font(qff_font);
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -161,7 +307,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -292,7 +438,8 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
     return false;
 }
 
-// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
+// Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph. The callback is responsible
+// for looking up the glyph, so that it can skip the glyph tables if it already knows what to draw.
 static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
@@ -302,13 +449,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -325,9 +466,15 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -345,15 +492,86 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
+    // Font preparation, deferred until a glyph actually needs decoding
+    qp_pixel_t fg_hsv888;
+    qp_pixel_t bg_hsv888;
+    bool       font_prepared;
 } code_point_iter_drawglyph_state_t;
 
+// Prepares the font on first use, then positions the stream at the glyph's pixel data
+static bool qp_drawtext_prepare_glyph_for_decode(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    if (!state->font_prepared) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset)) {
+            qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
+            return false;
+        }
+        state->font_prepared = true;
+    }
+
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
+    // Reset the input state's RLE mode -- the stream is now positioned at the start of the glyph
+    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+    return true;
+}
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+// Finds the glyph in the cache, decoding it into the cache if it's missing. Leaves the entry NULL if the glyph can't be
+// cached, in which case the stream is positioned for decoding it directly.
+static bool qp_drawtext_lookup_cached_glyph(code_point_iter_drawglyph_state_t *state, qff_font_handle_t *qff_font, uint32_t code_point, qp_glyph_cache_entry_t **entry, uint8_t *width) {
+    // Palette and native fonts look the same regardless of the requested colors
+    qp_pixel_t fg_hsv888 = state->fg_hsv888;
+    qp_pixel_t bg_hsv888 = state->bg_hsv888;
+    if (qff_font->has_palette || qff_font->is_panel_native) {
+        fg_hsv888 = bg_hsv888 = (qp_pixel_t){.hsv888 = {.h = 0, .s = 0, .v = 0}};
+    }
+
+    *entry = qp_glyph_cache_find(state->device, qff_font, code_point, fg_hsv888, bg_hsv888);
+    if (*entry != NULL) {
+        *width = (*entry)->width;
+        return true;
+    }
+
+    if (!qp_drawtext_prepare_glyph_for_decode(state, qff_font, code_point, width)) {
+        return false;
+    }
+    *entry = qp_glyph_cache_fill(state->device, qff_font, code_point, fg_hsv888, bg_hsv888, *width, state->input_callback, state->input_state);
+    if (*entry == NULL) {
+        // Rewind, the glyph gets decoded straight to the display instead
+        return qp_drawtext_prepare_glyph_for_decode(state, qff_font, code_point, width);
+    }
+    return true;
+}
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+    uint8_t                            width;
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
-    state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    qp_glyph_cache_entry_t *entry;
+    if (!qp_drawtext_lookup_cached_glyph(state, qff_font, code_point, &entry, &width)) {
+        return false;
+    }
+
+    if (entry != NULL) {
+        // Cached glyphs are already in the native pixel format, so they're sent as-is
+        driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+        state->xpos += width;
+        return driver->driver_vtable->pixdata(state->device, qp_glyph_cache_pixdata(entry), ((uint32_t)width) * height);
+    }
+#else  // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    if (!qp_drawtext_prepare_glyph_for_decode(state, qff_font, code_point, &width)) {
+        return false;
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
 
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
@@ -437,16 +655,11 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
-                                               .output_state = &output_state};
-
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
+                                               .output_state = &output_state,
+                                               // Font preparation, only needed once a glyph isn't cached
+                                               .fg_hsv888     = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}},
+                                               .bg_hsv888     = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}},
+                                               .font_prepared = false};
 
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
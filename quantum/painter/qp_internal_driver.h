@@ -38,12 +38,16 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef void (*painter_driver_comms_fence_func)(painter_device_t device);
 
 typedef struct painter_comms_vtable_t {
     painter_driver_comms_init_func  comms_init;
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+    // Optional: starts sending without waiting for completion, the data must stay untouched until comms_fence returns
+    painter_driver_comms_send_func  comms_send_async;
+    painter_driver_comms_fence_func comms_fence;
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -2,13 +2,30 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "qp_stream.h"
+#include <string.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Stream API
 
+static inline int16_t mem_get(qp_stream_t *stream);
+
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
+    // Memory streams can hand over the whole span in one go, hitting the end behaves the same as reading byte by byte
+    if (stream->get == mem_get) {
+        qp_memory_stream_t *s         = (qp_memory_stream_t *)stream;
+        uint32_t            count     = num_members * member_size;
+        uint32_t            available = s->length - s->position;
+        if (count > available) {
+            count     = available;
+            s->is_eof = true;
+        }
+        memcpy(output_ptr, &s->buffer[s->position], count);
+        s->position += count;
+        return count / member_size;
+    }
+
     uint32_t i;
     for (i = 0; i < (num_members * member_size); ++i) {
         int16_t c = qp_stream_get(stream);
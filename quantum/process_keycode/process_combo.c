@@ -16,6 +16,9 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#ifdef COMBO_KEYCODE_INDEX
+#    include <stdlib.h>
+#endif
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +29,13 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
+
+#if defined(COMBO_KEYCODE_INDEX) && defined(PROTOCOL_CHIBIOS)
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        error ChibiOS is configured without a memory allocator. Your keyboard may have set `#define CH_CFG_USE_MEMCORE FALSE`, which is incompatible with COMBO_KEYCODE_INDEX.
+#    endif
+#endif
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -85,6 +95,32 @@ static uint16_t timer = 0;
 static bool     b_combo_enable = true; // defaults to enabled
 static uint16_t longest_term   = 0;
 
+#ifdef COMBO_KEYCODE_INDEX
+static bool combos_dirty = false; // some combo state may need resetting
+
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+
+/* Entries sorted by keycode, then combo index, so each keycode maps to a
+ * contiguous run of the combos containing it in their original order.
+ * Allocated to fit the keys of the current combos. */
+static combo_index_entry_t *combo_keycode_index          = NULL;
+static uint16_t             combo_keycode_index_capacity = 0;
+static uint16_t             combo_keycode_index_size     = 0;
+static uint16_t             combo_keycode_index_count    = 0;
+static bool                 combo_keycode_index_built    = false;
+static bool                 combo_keycode_index_valid    = false;
+
+/* Combo keycodes seen since the last clear_combos(), as only the combos
+ * containing them can hold state that needs to be reset. */
+#    define COMBO_TOUCHED_KEYCODES_LENGTH COMBO_KEY_BUFFER_LENGTH
+static uint16_t touched_keycodes[COMBO_TOUCHED_KEYCODES_LENGTH];
+static uint8_t  touched_keycodes_size     = 0;
+static bool     touched_keycodes_overflow = false;
+#endif
+
 typedef struct {
     keyrecord_t record;
     uint16_t    combo_index;
@@ -199,9 +235,35 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
     return COMBO_TERM;
 }
 
+#ifdef COMBO_KEYCODE_INDEX
+static uint16_t combo_keycode_index_find(uint16_t keycode);
+#endif
+
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEYCODE_INDEX
+    /* Only combos containing a processed key can hold any state. */
+    if (!combos_dirty) {
+        return;
+    }
+    combos_dirty = false;
+    if (combo_keycode_index_valid && !touched_keycodes_overflow) {
+        for (uint8_t touched_i = 0; touched_i < touched_keycodes_size; ++touched_i) {
+            uint16_t keycode = touched_keycodes[touched_i];
+            for (uint16_t i = combo_keycode_index_find(keycode); i < combo_keycode_index_size && combo_keycode_index[i].keycode == keycode; ++i) {
+                combo_t *combo = combo_get(combo_keycode_index[i].combo_index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                }
+            }
+        }
+        touched_keycodes_size = 0;
+        return;
+    }
+    touched_keycodes_size     = 0;
+    touched_keycodes_overflow = false;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -264,7 +326,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -431,6 +492,9 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
     if (-1 == (int16_t)key_index) {
         return COMBO_KEY_NOT_PRESSED;
     }
+#ifdef COMBO_KEYCODE_INDEX
+    combos_dirty = true;
+#endif
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -551,9 +615,106 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
     return key_is_part_of_combo ? COMBO_KEY_PRESSED : COMBO_KEY_NOT_PRESSED;
 }
 
+#ifdef COMBO_KEYCODE_INDEX
+/* A combo is processed once per event, even if it lists a key twice. */
+static bool combo_key_is_duplicate(const uint16_t *keys, uint8_t key_i, uint16_t key) {
+    for (uint8_t prev_i = 0; prev_i < key_i; ++prev_i) {
+        if (pgm_read_word(&keys[prev_i]) == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int combo_index_entry_compare(const void *a, const void *b) {
+    const combo_index_entry_t *entry_a = a;
+    const combo_index_entry_t *entry_b = b;
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    return (int)entry_a->combo_index - (int)entry_b->combo_index;
+}
+
+void combo_keycode_index_rebuild(void) {
+    combo_keycode_index_size  = 0;
+    combo_keycode_index_count = combo_count();
+    combo_keycode_index_built = true;
+    combo_keycode_index_valid = false;
+    /* Touched keycodes refer to the previous combo table, clear all combos instead. */
+    touched_keycodes_overflow = true;
+
+    uint16_t entries = 0;
+    for (uint16_t idx = 0; idx < combo_keycode_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t key_i = 0; (key = pgm_read_word(&keys[key_i])) != COMBO_END; ++key_i) {
+            entries += combo_key_is_duplicate(keys, key_i, key) ? 0 : 1;
+        }
+    }
+
+    if (entries > combo_keycode_index_capacity) {
+        free(combo_keycode_index);
+        combo_keycode_index          = malloc(entries * sizeof(combo_index_entry_t));
+        combo_keycode_index_capacity = combo_keycode_index ? entries : 0;
+        if (!combo_keycode_index) {
+            dprintf("combo: could not allocate %u index entries, falling back to linear scan\n", entries);
+            return;
+        }
+    }
+
+    for (uint16_t idx = 0; idx < combo_keycode_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t key_i = 0; (key = pgm_read_word(&keys[key_i])) != COMBO_END; ++key_i) {
+            if (!combo_key_is_duplicate(keys, key_i, key)) {
+                combo_keycode_index[combo_keycode_index_size++] = (combo_index_entry_t){
+                    .keycode     = key,
+                    .combo_index = idx,
+                };
+            }
+        }
+    }
+
+    if (combo_keycode_index_size > 0) {
+        qsort(combo_keycode_index, combo_keycode_index_size, sizeof(combo_index_entry_t), combo_index_entry_compare);
+    }
+    combo_keycode_index_valid = true;
+}
+
+void combo_keycode_index_disable(void) {
+    combo_keycode_index_valid = false;
+}
+
+/* Returns the position of the first index entry for the keycode, if any. */
+static uint16_t combo_keycode_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_keycode_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_keycode_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static void combo_keycode_index_touch(uint16_t keycode) {
+    for (uint8_t touched_i = 0; touched_i < touched_keycodes_size; ++touched_i) {
+        if (touched_keycodes[touched_i] == keycode) {
+            return;
+        }
+    }
+    if (touched_keycodes_size < COMBO_TOUCHED_KEYCODES_LENGTH) {
+        touched_keycodes[touched_keycodes_size++] = keycode;
+    } else {
+        touched_keycodes_overflow = true;
+    }
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    uint8_t is_combo_key          = COMBO_KEY_NOT_PRESSED;
-    bool    no_combo_keys_pressed = true;
+    uint8_t is_combo_key = COMBO_KEY_NOT_PRESSED;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -581,10 +742,27 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEYCODE_INDEX
+    if (!combo_keycode_index_built || combo_keycode_index_count != combo_count()) {
+        combo_keycode_index_rebuild();
+    }
+
+    if (combo_keycode_index_valid) {
+        /* Only visit the combos that contain this keycode. */
+        uint16_t i = combo_keycode_index_find(keycode);
+        if (i < combo_keycode_index_size && combo_keycode_index[i].keycode == keycode) {
+            combo_keycode_index_touch(keycode);
+        }
+        for (; i < combo_keycode_index_size && combo_keycode_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_keycode_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -647,6 +825,18 @@ void combo_task(void) {
 #endif
 }
 
+bool combo_next_deadline(uint32_t *deadline) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        // combo_task() resolves the buffered keys once longest_term has been exceeded
+        const uint16_t elapsed = timer_elapsed(timer);
+        *deadline              = timer_read32() + (elapsed > longest_term ? 0 : longest_term + 1 - elapsed);
+        return true;
+    }
+#endif
+    return false;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
@@ -75,8 +75,15 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+bool combo_next_deadline(uint32_t *deadline);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+#ifdef COMBO_KEYCODE_INDEX
+void combo_keycode_index_rebuild(void);
+// Processes key events with the linear scan until the index is next rebuilt
+void combo_keycode_index_disable(void);
+#endif
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
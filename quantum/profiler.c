@@ -0,0 +1,210 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "profiler.h"
+#include <string.h>
+#include "print.h"
+#include "debug.h"
+#include "util.h"
+
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
+
+#if defined(__AVR__)
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+extern volatile uint32_t timer_count;
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include "chibios_config.h"
+#else
+#    include <time.h>
+#endif
+
+static profiler_probe_t probes[PROFILER_MAX_PROBES];
+static uint8_t          probe_count = 0;
+
+void profiler_init(void) {
+    profiler_reset();
+}
+
+uint32_t profiler_read_counter(void) {
+#if defined(__AVR__)
+    // Timer 0 ticks every TIMER_PRESCALER cycles and wraps each millisecond.
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+    }
+    return ms * (F_CPU / 1000) + (uint32_t)raw * TIMER_PRESCALER;
+#elif defined(PROTOCOL_CHIBIOS)
+    // DWT cycle counter on Cortex-M3 and above, a free running timer otherwise.
+    return chSysGetRealtimeCounterX();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+uint32_t profiler_counter_frequency(void) {
+#if defined(__AVR__)
+    return F_CPU;
+#elif defined(PROTOCOL_CHIBIOS)
+    return REALTIME_COUNTER_CLOCK;
+#else
+    return 1000000000UL;
+#endif
+}
+
+uint8_t profiler_register_probe(const char *name) {
+    for (uint8_t i = 0; i < probe_count; i++) {
+        if (strcmp(probes[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (probe_count >= PROFILER_MAX_PROBES) {
+        dprintf("profiler: no room for probe %s, increase PROFILER_MAX_PROBES\n", name);
+        return PROFILER_INVALID_PROBE;
+    }
+    probes[probe_count].name = name;
+    probes[probe_count].min  = UINT32_MAX;
+    return probe_count++;
+}
+
+uint32_t profiler_probe_begin(uint8_t *probe, const char *name) {
+    if (*probe == PROFILER_INVALID_PROBE) {
+        *probe = profiler_register_probe(name);
+    }
+    return profiler_read_counter();
+}
+
+static uint8_t histogram_bucket(uint32_t ticks) {
+    uint8_t bits = 0;
+    while (ticks) {
+        ticks >>= 1;
+        bits++;
+    }
+    if (bits <= PROFILER_HISTOGRAM_MIN_BITS) {
+        return 0;
+    }
+    return MIN(bits - PROFILER_HISTOGRAM_MIN_BITS, PROFILER_HISTOGRAM_BUCKETS - 1);
+}
+
+void profiler_record(uint8_t probe, uint32_t ticks) {
+    if (probe >= probe_count) {
+        return;
+    }
+
+    profiler_probe_t *p = &probes[probe];
+    p->count++;
+    p->total += ticks;
+    if (ticks < p->min) {
+        p->min = ticks;
+    }
+    if (ticks > p->max) {
+        p->max = ticks;
+    }
+    uint16_t *bucket = &p->histogram[histogram_bucket(ticks)];
+    if (*bucket < UINT16_MAX) {
+        (*bucket)++;
+    }
+}
+
+uint8_t profiler_probe_count(void) {
+    return probe_count;
+}
+
+const profiler_probe_t *profiler_get_probe(uint8_t probe) {
+    if (probe >= probe_count) {
+        return NULL;
+    }
+    return &probes[probe];
+}
+
+void profiler_reset(void) {
+    for (uint8_t i = 0; i < probe_count; i++) {
+        const char *name = probes[i].name;
+        memset(&probes[i], 0, sizeof(profiler_probe_t));
+        probes[i].name = name;
+        probes[i].min  = UINT32_MAX;
+    }
+}
+
+static inline uint32_t probe_average(const profiler_probe_t *p) {
+    return p->count ? (uint32_t)(p->total / p->count) : 0;
+}
+
+void profiler_print(void) {
+    xprintf("profiler: %lu ticks/s\n", (unsigned long)profiler_counter_frequency());
+    for (uint8_t i = 0; i < probe_count; i++) {
+        __attribute__((unused)) const profiler_probe_t *p = &probes[i];
+        xprintf("%s: count %lu, min %lu, avg %lu, max %lu\n", p->name, (unsigned long)p->count, (unsigned long)(p->count ? p->min : 0), (unsigned long)probe_average(p), (unsigned long)p->max);
+        xprintf("  histogram:");
+        for (uint8_t b = 0; b < PROFILER_HISTOGRAM_BUCKETS; b++) {
+            xprintf(" %u", p->histogram[b]);
+        }
+        xprintf("\n");
+    }
+}
+
+#ifdef RAW_ENABLE
+static void write_u32(uint8_t *dest, uint32_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+    dest[2] = (value >> 16) & 0xFF;
+    dest[3] = (value >> 24) & 0xFF;
+}
+
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (data[0] != PROFILER_RAW_HID_ID) {
+        return false;
+    }
+
+    uint8_t                 command      = data[1];
+    const profiler_probe_t *p            = profiler_get_probe(data[2]);
+    uint8_t                 first_bucket = data[3];
+    memset(&data[2], 0, length - 2);
+
+    switch (command) {
+        case profiler_raw_hid_get_info:
+            // [2] probe count, [3] histogram buckets, [4] histogram min bits, [5..8] counter frequency
+            data[2] = probe_count;
+            data[3] = PROFILER_HISTOGRAM_BUCKETS;
+            data[4] = PROFILER_HISTOGRAM_MIN_BITS;
+            write_u32(&data[5], profiler_counter_frequency());
+            break;
+        case profiler_raw_hid_get_stats:
+            // [2..5] count, [6..9] min, [10..13] avg, [14..17] max, [18..] name
+            if (p) {
+                write_u32(&data[2], p->count);
+                write_u32(&data[6], p->count ? p->min : 0);
+                write_u32(&data[10], probe_average(p));
+                write_u32(&data[14], p->max);
+                strncpy((char *)&data[18], p->name, length - 18 - 1);
+            }
+            break;
+        case profiler_raw_hid_get_histogram:
+            // [3] first bucket, [4..] little endian 16 bit counts from the first bucket onwards
+            data[3] = first_bucket;
+            if (p) {
+                for (uint8_t b = first_bucket, i = 4; b < PROFILER_HISTOGRAM_BUCKETS && i + 1 < length; b++, i += 2) {
+                    data[i]     = p->histogram[b] & 0xFF;
+                    data[i + 1] = p->histogram[b] >> 8;
+                }
+            }
+            break;
+        case profiler_raw_hid_reset:
+            profiler_reset();
+            break;
+        default:
+            data[1] = 0xFF;
+            break;
+    }
+
+    raw_hid_send(data, length);
+    return true;
+}
+#endif // RAW_ENABLE
@@ -0,0 +1,159 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    This API collects per-call timing statistics for named probe points.
+
+    Usage example:
+
+        #include "profiler.h"
+
+        // Original code:
+        matrix_task();
+
+        // Delete the original, replace with the following (variant 1, automatic naming):
+        PROFILER_CALL(matrix_task());
+
+        // Delete the original, replace with the following (variant 2, explicit naming):
+        PROFILER_CALL_NAMED("matrix_task", {
+            matrix_task();
+        });
+
+        // Or time an arbitrary span within a function:
+        PROFILER_START(my_span);
+        ...
+        PROFILER_STOP(my_span);
+
+    Statistics are kept in counter ticks, see profiler_counter_frequency().
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef PROFILER_MAX_PROBES
+#    define PROFILER_MAX_PROBES 8
+#endif
+
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    define PROFILER_HISTOGRAM_BUCKETS 16
+#endif
+
+// Bucket 0 holds durations below 2^PROFILER_HISTOGRAM_MIN_BITS ticks, each
+// following bucket doubles the upper bound, the last bucket is open ended.
+#ifndef PROFILER_HISTOGRAM_MIN_BITS
+#    define PROFILER_HISTOGRAM_MIN_BITS 6
+#endif
+
+#ifndef PROFILER_RAW_HID_ID
+#    define PROFILER_RAW_HID_ID 0xF0
+#endif
+
+#define PROFILER_INVALID_PROBE 0xFF
+
+typedef struct profiler_probe_t {
+    const char *name;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    total;
+    uint16_t    histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_probe_t;
+
+typedef enum profiler_raw_hid_command_t {
+    profiler_raw_hid_get_info      = 0x01,
+    profiler_raw_hid_get_stats     = 0x02,
+    profiler_raw_hid_get_histogram = 0x03,
+    profiler_raw_hid_reset         = 0x04,
+} profiler_raw_hid_command_t;
+
+#ifdef PROFILER_ENABLE
+
+#    define PROFILER_START(name)                                       \
+        static uint8_t profiler_probe_##name = PROFILER_INVALID_PROBE; \
+        const uint32_t profiler_start_##name = profiler_probe_begin(&profiler_probe_##name, #name)
+
+#    define PROFILER_STOP(name) profiler_record(profiler_probe_##name, profiler_read_counter() - profiler_start_##name)
+
+#    define PROFILER_CALL_NAMED(name, call)                                                          \
+        do {                                                                                         \
+            static uint8_t profiler_call_probe = PROFILER_INVALID_PROBE;                             \
+            const uint32_t profiler_call_start = profiler_probe_begin(&profiler_call_probe, (name)); \
+            do {                                                                                     \
+                call;                                                                                \
+            } while (0);                                                                             \
+            profiler_record(profiler_call_probe, profiler_read_counter() - profiler_call_start);     \
+        } while (0)
+
+/**
+ * \brief Initialises the counter used for timing, called from keyboard_init().
+ */
+void profiler_init(void);
+
+/**
+ * \brief Reads the free running counter used for timing.
+ */
+uint32_t profiler_read_counter(void);
+
+/**
+ * \brief Frequency of the counter returned by profiler_read_counter(), in Hz.
+ */
+uint32_t profiler_counter_frequency(void);
+
+/**
+ * \brief Registers a probe on first use and returns the current counter value.
+ *
+ * \param probe Storage for the probe index, PROFILER_INVALID_PROBE until registered.
+ * \param name  Name of the probe, must remain valid for the lifetime of the firmware.
+ */
+uint32_t profiler_probe_begin(uint8_t *probe, const char *name);
+
+/**
+ * \brief Registers a named probe, returning its index or PROFILER_INVALID_PROBE if the table is full.
+ */
+uint8_t profiler_register_probe(const char *name);
+
+/**
+ * \brief Adds a duration, in counter ticks, to the statistics of a probe.
+ */
+void profiler_record(uint8_t probe, uint32_t ticks);
+
+/**
+ * \brief Number of registered probes.
+ */
+uint8_t profiler_probe_count(void);
+
+/**
+ * \brief Statistics of a registered probe, NULL if the index is out of range.
+ */
+const profiler_probe_t *profiler_get_probe(uint8_t probe);
+
+/**
+ * \brief Clears the statistics of all probes, keeping their registration.
+ */
+void profiler_reset(void);
+
+/**
+ * \brief Prints the statistics of all probes over the console.
+ */
+void profiler_print(void);
+
+/**
+ * \brief Handles a profiler raw HID request.
+ *
+ * \return true if the request was addressed to the profiler and a reply has been sent.
+ */
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#else
+
+#    define PROFILER_START(name)
+#    define PROFILER_STOP(name)
+#    define PROFILER_CALL_NAMED(name, call) \
+        do {                                \
+            call;                           \
+        } while (0)
+
+#endif // PROFILER_ENABLE
+
+#define PROFILER_CALL(call) PROFILER_CALL_NAMED(#call, call)
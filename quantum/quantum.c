@@ -84,6 +84,10 @@
 #    include "process_layer_lock.h"
 #endif
 
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DEFERRED_COMMIT)
+#    include "wear_leveling.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -208,6 +212,12 @@ __attribute__((weak)) void suspend_wakeup_init_modules(void) {}
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_CACHE)
+    dynamic_keymap_cache_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DEFERRED_COMMIT)
+    wear_leveling_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -292,154 +302,204 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_record(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
-#endif
+typedef bool (*process_record_handler_t)(uint16_t keycode, keyrecord_t *record);
 
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
-#endif
+typedef struct {
+    uint16_t                 first;
+    uint16_t                 last;
+    process_record_handler_t handler;
+} process_record_handler_range_t;
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
-#endif
+#define PROCESS_RECORD_RANGE(first, last, handler) {(first), (last), (handler)}
+#define PROCESS_RECORD_ALL(handler) PROCESS_RECORD_RANGE(0x0000, 0xFFFF, handler)
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+/* Handlers run in this order, each one only for the keycodes it can claim.
+ * Handlers which inspect every key event, e.g. to track the last key or
+ * to cancel on other keys, span the full keycode range. */
+static const process_record_handler_range_t process_record_handler_ranges[] PROGMEM = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ALL(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    PROCESS_RECORD_ALL(process_last_key),
+    PROCESS_RECORD_RANGE(QK_REPEAT_KEY, QK_ALT_REPEAT_KEY, process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    PROCESS_RECORD_ALL(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    PROCESS_RECORD_ALL(process_haptic),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_mouse),
 #endif
-            process_record_modules(keycode, record) && // modules must run before kb
-            process_record_kb(keycode, record) &&
+    PROCESS_RECORD_ALL(process_record_modules), // modules must run before kb
+    PROCESS_RECORD_ALL(process_record_kb),
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MACRO, QK_MACRO_MAX, process_record_via),
 #endif
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    PROCESS_RECORD_ALL(process_secure),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_SEQUENCER, QK_SEQUENCER_MAX, process_sequencer),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MIDI, QK_MIDI_MAX, process_midi),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_AUDIO, QK_AUDIO_MAX, process_audio),
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, QK_LIGHTING_MAX, process_backlight),
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, QK_LIGHTING_MAX, process_led_matrix),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_STENO, QK_STENO_MAX, process_steno),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    PROCESS_RECORD_ALL(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    PROCESS_RECORD_ALL(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    PROCESS_RECORD_ALL(process_key_override_record),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_TAP_DANCE, QK_TAP_DANCE_MAX, process_tap_dance),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+#    ifdef UCIS_ENABLE
+    // UCIS consumes regular keycodes while an input is in progress
+    PROCESS_RECORD_ALL(process_unicode_common),
+#    else
+    PROCESS_RECORD_RANGE(QK_UNICODE_MODE_NEXT, QK_UNICODE_MAX, process_unicode_common),
+#    endif
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    PROCESS_RECORD_ALL(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    PROCESS_RECORD_ALL(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN, process_dynamic_tapping_term),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    PROCESS_RECORD_ALL(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_MAGIC, QK_MAGIC_MAX, process_magic),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, process_grave_esc),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_underglow(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, QK_LIGHTING_MAX, process_underglow),
 #endif
 #if defined(RGB_MATRIX_ENABLE)
-            process_rgb_matrix(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_LIGHTING, QK_LIGHTING_MAX, process_rgb_matrix),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_JOYSTICK, QK_JOYSTICK_MAX, process_joystick),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX, process_programmable_button),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    PROCESS_RECORD_ALL(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER, process_tri_layer),
 #endif
 #if !defined(NO_ACTION_LAYER)
-            process_default_layer(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_PERSISTENT_DEF_LAYER, QK_PERSISTENT_DEF_LAYER_MAX, process_default_layer),
 #endif
 #ifdef LAYER_LOCK_ENABLE
-            process_layer_lock(keycode, record) &&
+    PROCESS_RECORD_ALL(process_layer_lock),
 #endif
 #ifdef CONNECTION_ENABLE
-            process_connection(keycode, record) &&
+    PROCESS_RECORD_RANGE(QK_CONNECTION, QK_CONNECTION_MAX, process_connection),
+#endif
+};
+
+/* Runs the handlers whose keycode range contains the keycode, stopping at the
+ * first one which returns false. */
+static bool process_record_handlers(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handler_ranges); i++) {
+        const process_record_handler_range_t *range = &process_record_handler_ranges[i];
+        uint16_t                              first = pgm_read_word(&range->first);
+
+        // Unsigned wraparound folds both bounds into a single comparison
+        if ((uint16_t)(keycode - first) > (uint16_t)(pgm_read_word(&range->last) - first)) {
+            continue;
+        }
+        process_record_handler_t handler = (process_record_handler_t)pgm_read_ptr(&range->handler);
+        if (!handler(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
 #endif
-            true)) {
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
+#endif
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
+#endif
+
+    if (!process_record_handlers(keycode, record)) {
         return false;
     }
 
@@ -4,11 +4,20 @@
 #include "raw_hid.h"
 #include "host.h"
 
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
+
 void raw_hid_send(uint8_t *data, uint8_t length) {
     host_raw_hid_send(data, length);
 }
 
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
+#ifdef PROFILER_ENABLE
+    if (profiler_raw_hid_receive(data, length)) {
+        return;
+    }
+#endif
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
     // so users can opt to not handle data coming in.
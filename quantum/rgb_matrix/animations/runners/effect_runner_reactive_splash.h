@@ -7,22 +7,41 @@ typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t di
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t                count = g_last_hit_tracker.count;
+    rgb_matrix_hsv_batch_t batch = {0};
+#    ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+    // Each hit's neighbours are sorted by index, so they are walked alongside the LEDs
+    const rgb_matrix_neighbour_t *neighbour[LED_HITS_TO_REMEMBER];
+    const rgb_matrix_neighbour_t *neighbour_end[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        uint8_t neighbour_count;
+        neighbour[j]     = rgb_matrix_neighbours(g_last_hit_tracker.index[j], &neighbour_count);
+        neighbour_end[j] = neighbour[j] + neighbour_count;
+    }
+#    endif
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         hsv_t hsv = rgb_matrix_config.hsv;
         hsv.v     = 0;
         for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+#    ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+            while (neighbour[j] != neighbour_end[j] && neighbour[j]->index < i) {
+                neighbour[j]++;
+            }
+            // LEDs outside of the radius, and the hit LED itself, are not in the table
+            uint8_t dist = (neighbour[j] != neighbour_end[j] && neighbour[j]->index == i) ? neighbour[j]->distance : sqrt16(dx * dx + dy * dy);
+#    else
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+#    endif
             uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
             hsv           = effect_func(hsv, dx, dy, dist, tick);
         }
-        hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
-        rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        hsv.v = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_matrix_hsv_batch_add(&batch, i, hsv);
     }
+    rgb_matrix_hsv_batch_flush(&batch);
     return rgb_matrix_check_finished_leds(led_max);
 }
 
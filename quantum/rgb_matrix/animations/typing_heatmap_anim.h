@@ -16,6 +16,48 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM)
+static inline uint8_t typing_heatmap_spread_amount(uint8_t distance) {
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+    }
+    return amount;
+}
+#        endif
+
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && defined(RGB_MATRIX_NEIGHBOUR_TABLE) && RGB_MATRIX_TYPING_HEATMAP_SPREAD <= RGB_MATRIX_NEIGHBOUR_RADIUS
+#            define TYPING_HEATMAP_USE_NEIGHBOURS
+// Matrix position of each LED, built on first use. Keyboards where several keys
+// share an LED keep using the matrix scan below.
+static uint8_t typing_heatmap_led_row[RGB_MATRIX_LED_COUNT];
+static uint8_t typing_heatmap_led_col[RGB_MATRIX_LED_COUNT];
+static int8_t  typing_heatmap_led_map = 0; // 0: not built, 1: usable, -1: shared LEDs
+
+static bool typing_heatmap_led_map_usable(void) {
+    if (typing_heatmap_led_map == 0) {
+        memset(typing_heatmap_led_row, 0xFF, sizeof typing_heatmap_led_row);
+        typing_heatmap_led_map = 1;
+        for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+            for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                uint8_t led = g_led_config.matrix_co[i_row][i_col];
+                if (led == NO_LED) {
+                    continue;
+                }
+                if (typing_heatmap_led_row[led] != 0xFF) {
+                    typing_heatmap_led_map = -1;
+                    return false;
+                }
+                typing_heatmap_led_row[led] = i_row;
+                typing_heatmap_led_col[led] = i_col;
+            }
+        }
+    }
+    return typing_heatmap_led_map > 0;
+}
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
@@ -24,6 +66,23 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+#            ifdef TYPING_HEATMAP_USE_NEIGHBOURS
+    if (rgb_matrix_neighbours_valid() && typing_heatmap_led_map_usable()) {
+        // Only visit the LEDs within the spread instead of the whole matrix
+        uint8_t                       count;
+        const rgb_matrix_neighbour_t *neighbour = rgb_matrix_neighbours(g_led_config.matrix_co[row][col], &count);
+        g_rgb_frame_buffer[row][col]            = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+        for (uint8_t k = 0; k < count; k++) {
+            uint8_t i_row = typing_heatmap_led_row[neighbour[k].index];
+            if (neighbour[k].distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD || i_row == 0xFF) {
+                continue;
+            }
+            uint8_t i_col                    = typing_heatmap_led_col[neighbour[k].index];
+            g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], typing_heatmap_spread_amount(neighbour[k].distance));
+        }
+        return;
+    }
+#            endif
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
             if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
@@ -36,11 +95,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
                 uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
 #            undef LED_DISTANCE
                 if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
+                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], typing_heatmap_spread_amount(distance));
                 }
             }
         }
@@ -34,10 +34,38 @@ const led_point_t k_rgb_matrix_center = {112, 32};
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
+// Set by the default conversion, which keyboards don't replace once it has run
+static bool rgb_matrix_hsv_to_rgb_is_default = false;
+
 __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    rgb_matrix_hsv_to_rgb_is_default = true;
     return hsv_to_rgb(hsv);
 }
 
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+    if (count == 0) {
+        return;
+    }
+    rgb[0] = rgb_matrix_hsv_to_rgb(hsv[0]);
+    // The batch kernel matches the default conversion only, overrides run for each color
+    if (rgb_matrix_hsv_to_rgb_is_default) {
+        hsv_to_rgb_batch(&hsv[1], &rgb[1], count - 1);
+        return;
+    }
+    for (uint8_t i = 1; i < count; i++) {
+        rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+    }
+}
+
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch) {
+    rgb_t rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -70,6 +98,7 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // RGB_MATRIX_FRAMEBUFFER_EFFECTS
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
+uint8_t    g_last_hit_led[RGB_MATRIX_LED_COUNT];
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
@@ -82,7 +111,7 @@ static rgb_task_states rgb_task_state    = SYNCING;
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
+static last_hit_buffer_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // split rgb matrix
@@ -90,6 +119,38 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+#    define RGB_MATRIX_LED_MASK_SIZE ((RGB_MATRIX_LED_COUNT + 7) / 8)
+#    define LED_MASK_SET(mask, i) ((mask)[(i) / 8] |= (1 << ((i) % 8)))
+#    define LED_MASK_GET(mask, i) ((mask)[(i) / 8] & (1 << ((i) % 8)))
+
+// How the output of an effect changes from one frame to the next
+typedef enum rgb_render_mode_t {
+    RENDER_EVERY_FRAME, // animated, all LEDs are rendered every frame
+    RENDER_STATIC,      // only depends on rgb_matrix_config
+    RENDER_REACTIVE,    // static apart from the LEDs in the last hit tracker
+    RENDER_SPLASH_WAVE, // static apart from rings travelling outwards from each hit
+    RENDER_SPLASH_FADE, // static apart from glows shrinking around each hit
+} rgb_render_mode_t;
+
+// frame the effects render into, and what the driver has last been sent
+static rgb_t rgb_frame[RGB_MATRIX_LED_COUNT];
+static rgb_t rgb_flushed[RGB_MATRIX_LED_COUNT];
+static bool  rgb_force_push = true;
+
+// LEDs the effect renders this frame, and LEDs written outside of the effect
+static uint8_t rgb_render_mask[RGB_MATRIX_LED_MASK_SIZE];
+static uint8_t rgb_touched_mask[RGB_MATRIX_LED_MASK_SIZE];
+static bool    rgb_in_effect = false;
+
+static rgb_config_t rgb_rendered_config;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static uint8_t  rgb_hit_mask[RGB_MATRIX_LED_MASK_SIZE];
+static uint32_t rgb_rendered_timer;
+static bool     rgb_hits_dropped = false;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#endif     // RGB_MATRIX_DIRTY_TRACKING
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, rgb_matrix_config);
 
 void eeconfig_force_flush_rgb_matrix(void) {
@@ -141,7 +202,27 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+// Sends the LEDs that changed since the last push to the driver, returns true if there were any.
+static bool rgb_matrix_push_frame(void) {
+    bool changed = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (!rgb_force_push && memcmp(&rgb_frame[i], &rgb_flushed[i], sizeof(rgb_t)) == 0) {
+            continue;
+        }
+        rgb_flushed[i] = rgb_frame[i];
+        rgb_matrix_driver.set_color(rgb_matrix_led_index(i), rgb_frame[i].r, rgb_frame[i].g, rgb_frame[i].b);
+        changed = true;
+    }
+    rgb_force_push = false;
+    return changed;
+}
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
 void rgb_matrix_update_pwm_buffers(void) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_matrix_push_frame();
+#endif
     rgb_matrix_driver.flush();
 }
 
@@ -155,11 +236,20 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (index < 0 || index >= RGB_MATRIX_LED_COUNT) return;
+    rgb_frame[index] = (rgb_t){.r = red, .g = green, .b = blue};
+    if (!rgb_in_effect) {
+        // indicators and user code paint over the effect, re-render these LEDs next frame
+        LED_MASK_SET(rgb_touched_mask, index);
+    }
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_SPLIT) || defined(RGB_MATRIX_DIRTY_TRACKING)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -167,6 +257,13 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#if defined(RGB_MATRIX_DIRTY_TRACKING) && defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
+// Reactive effects have faded out once the scaled tick is past both the wave and the glow extents.
+static bool rgb_hit_visible(uint16_t tick) {
+    return scale16by8(tick, qadd8(rgb_matrix_config.speed, 1)) < 2 * 255;
+}
+#endif // defined(RGB_MATRIX_DIRTY_TRACKING) && defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -185,21 +282,13 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        uint16_t dropped_tick;
+        if (last_hit_push(&last_hit_buffer, led[i], g_led_config.point[led[i]].x, g_led_config.point[led[i]].y, &dropped_tick)) {
+#    ifdef RGB_MATRIX_DIRTY_TRACKING
+            rgb_hits_dropped |= rgb_hit_visible(dropped_tick);
+#    endif // RGB_MATRIX_DIRTY_TRACKING
+        }
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -250,6 +339,171 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+static rgb_render_mode_t rgb_matrix_render_mode(uint8_t effect) {
+    switch (effect) {
+        case RGB_MATRIX_SOLID_COLOR:
+#    ifdef ENABLE_RGB_MATRIX_ALPHAS_MODS
+        case RGB_MATRIX_ALPHAS_MODS:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_UP_DOWN
+        case RGB_MATRIX_GRADIENT_UP_DOWN:
+#    endif
+#    ifdef ENABLE_RGB_MATRIX_GRADIENT_LEFT_RIGHT
+        case RGB_MATRIX_GRADIENT_LEFT_RIGHT:
+#    endif
+            return RENDER_STATIC;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#        ifndef RGB_MATRIX_SOLID_REACTIVE_GRADIENT_MODE
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
+        case RGB_MATRIX_SOLID_REACTIVE_SIMPLE:
+#            endif
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE
+        case RGB_MATRIX_SOLID_REACTIVE:
+#            endif
+            return RENDER_REACTIVE;
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE
+        case RGB_MATRIX_SOLID_REACTIVE_WIDE:
+#            endif
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE
+        case RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE:
+#            endif
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS
+        case RGB_MATRIX_SOLID_REACTIVE_CROSS:
+#            endif
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS
+        case RGB_MATRIX_SOLID_REACTIVE_MULTICROSS:
+#            endif
+            return RENDER_SPLASH_FADE;
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS
+        case RGB_MATRIX_SOLID_REACTIVE_NEXUS:
+#            endif
+#            ifdef ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS
+        case RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS:
+#            endif
+#        endif // RGB_MATRIX_SOLID_REACTIVE_GRADIENT_MODE
+#        ifdef ENABLE_RGB_MATRIX_SPLASH
+        case RGB_MATRIX_SPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_MULTISPLASH
+        case RGB_MATRIX_MULTISPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
+        case RGB_MATRIX_SOLID_SPLASH:
+#        endif
+#        ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
+        case RGB_MATRIX_SOLID_MULTISPLASH:
+#        endif
+            return RENDER_SPLASH_WAVE;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+        default:
+            return RENDER_EVERY_FRAME;
+    }
+}
+
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_mark_leds_in_range(uint8_t led, uint8_t x, uint8_t y, uint8_t min_dist, uint8_t max_dist) {
+#        ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+    if (max_dist <= RGB_MATRIX_NEIGHBOUR_RADIUS && rgb_matrix_neighbours_valid()) {
+        uint8_t                       count;
+        const rgb_matrix_neighbour_t *neighbour = rgb_matrix_neighbours(led, &count);
+        if (min_dist == 0) {
+            LED_MASK_SET(rgb_render_mask, led);
+        }
+        for (uint8_t k = 0; k < count; k++) {
+            if (neighbour[k].distance >= min_dist && neighbour[k].distance <= max_dist) {
+                LED_MASK_SET(rgb_render_mask, neighbour[k].index);
+            }
+        }
+        return;
+    }
+#        endif // RGB_MATRIX_NEIGHBOUR_TABLE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - x;
+        int16_t dy = g_led_config.point[i].y - y;
+        if (abs(dx) > max_dist || abs(dy) > max_dist) continue;
+        uint8_t dist = sqrt16(dx * dx + dy * dy);
+        if (dist >= min_dist && dist <= max_dist) {
+            LED_MASK_SET(rgb_render_mask, i);
+        }
+    }
+}
+
+static void rgb_mark_hits(rgb_render_mode_t mode) {
+    if (mode == RENDER_REACTIVE) {
+        // keys in the tracker, and keys that dropped out of it since the last frame
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_MASK_SIZE; i++) {
+            rgb_render_mask[i] |= rgb_hit_mask[i];
+        }
+        memset(rgb_hit_mask, 0, sizeof(rgb_hit_mask));
+        for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+            LED_MASK_SET(rgb_hit_mask, g_last_hit_tracker.index[j]);
+        }
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_MASK_SIZE; i++) {
+            rgb_render_mask[i] |= rgb_hit_mask[i];
+        }
+        return;
+    }
+
+    // Splash effects only change LEDs within a distance band around each hit. Cover the band
+    // of the last frame too, so LEDs the effect has moved away from are restored.
+    uint32_t elapsed = g_rgb_timer - rgb_rendered_timer;
+    uint8_t  speed   = qadd8(rgb_matrix_config.speed, 1);
+    for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+        uint16_t tick     = g_last_hit_tracker.tick[j];
+        uint16_t now      = scale16by8(tick, speed);
+        uint16_t prev     = scale16by8(tick > elapsed ? tick - elapsed : 0, speed);
+        uint16_t min_dist = 0;
+        uint16_t max_dist;
+        if (mode == RENDER_SPLASH_WAVE) {
+            // effect = tick - dist is visible from tick - 254 up to tick
+            min_dist = prev > 254 ? prev - 254 : 0;
+            max_dist = MIN(now, 255);
+        } else {
+            // effect = tick + dist is visible below 255 - tick
+            if (prev > 254) continue;
+            max_dist = 254 - prev;
+        }
+        if (min_dist > max_dist) continue;
+        rgb_mark_leds_in_range(g_last_hit_tracker.index[j], g_last_hit_tracker.x[j], g_last_hit_tracker.y[j], min_dist, max_dist);
+    }
+}
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+static void rgb_task_prepare_render_mask(uint8_t effect) {
+    rgb_render_mode_t mode    = rgb_matrix_render_mode(effect);
+    bool              changed = effect != rgb_last_effect || rgb_matrix_config.enable != rgb_last_enable;
+    bool              full    = changed || mode == RENDER_EVERY_FRAME || rgb_matrix_config.raw != rgb_rendered_config.raw;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    full |= rgb_hits_dropped && mode >= RENDER_SPLASH_WAVE;
+    rgb_hits_dropped = false;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    rgb_rendered_config = rgb_matrix_config;
+    if (changed) {
+        // the driver may have been reinitialised or shut down, resend everything
+        rgb_force_push = true;
+    }
+
+    if (full) {
+        memset(rgb_render_mask, 0xFF, sizeof(rgb_render_mask));
+    } else {
+        memcpy(rgb_render_mask, rgb_touched_mask, sizeof(rgb_render_mask));
+    }
+    memset(rgb_touched_mask, 0, sizeof(rgb_touched_mask));
+
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    if (mode >= RENDER_REACTIVE) {
+        rgb_mark_hits(mode);
+    }
+    rgb_rendered_timer = g_rgb_timer;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+}
+
+bool rgb_matrix_led_needs_render(uint8_t index) {
+    return LED_MASK_GET(rgb_render_mask, index);
+}
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -258,13 +512,11 @@ static void rgb_task_timers(void) {
 
     // Update double buffer last hit timers
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
+    if (last_hit_advance(&last_hit_buffer, deltaTime)) {
+#    ifdef RGB_MATRIX_DIRTY_TRACKING
+        // the dropped hits were at least UINT16_MAX - deltaTime old
+        rgb_hits_dropped |= rgb_hit_visible(deltaTime < UINT16_MAX ? UINT16_MAX - deltaTime : 0);
+#    endif // RGB_MATRIX_DIRTY_TRACKING
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
@@ -282,7 +534,7 @@ static void rgb_task_start(void) {
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
+    last_hit_snapshot(&last_hit_buffer, &g_last_hit_tracker, g_last_hit_led, RGB_MATRIX_LED_COUNT);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     // next task
@@ -364,15 +616,20 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    // nothing to send when the frame matches what the driver already has
+    if (rgb_matrix_push_frame()) {
+        rgb_matrix_driver.flush();
+    }
+#else
     rgb_matrix_update_pwm_buffers();
+#endif
 
     // next task
     rgb_task_state = SYNCING;
 }
 
-void rgb_matrix_task(void) {
-    rgb_task_timers();
-
+static uint8_t rgb_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -381,14 +638,29 @@ void rgb_matrix_task(void) {
 #endif // RGB_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+    return suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+}
+
+void rgb_matrix_task(void) {
+    rgb_task_timers();
+
+    uint8_t effect = rgb_task_effect();
 
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+            rgb_task_prepare_render_mask(effect);
+#endif
             break;
         case RENDERING:
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+            rgb_in_effect = true;
+            rgb_task_render(effect);
+            rgb_in_effect = false;
+#else
             rgb_task_render(effect);
+#endif
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
                     rgb_matrix_indicators();
@@ -405,6 +677,22 @@ void rgb_matrix_task(void) {
     }
 }
 
+bool rgb_matrix_next_deadline(uint32_t *deadline) {
+    if (rgb_task_state != SYNCING) {
+        // a frame is being rendered across several calls to rgb_matrix_task()
+        *deadline = timer_read32();
+        return true;
+    }
+    if (!rgb_task_effect() && !rgb_last_effect && rgb_last_enable == rgb_matrix_config.enable) {
+        // the blank frame has been flushed, nothing changes until the matrix is turned back on
+        return false;
+    }
+
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    *deadline        = timer_read32() + (elapsed >= RGB_MATRIX_LED_FLUSH_LIMIT ? 0 : RGB_MATRIX_LED_FLUSH_LIMIT - elapsed);
+    return true;
+}
+
 __attribute__((weak)) bool rgb_matrix_indicators_modules(void) {
     return true;
 }
@@ -476,16 +764,13 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
+#ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+    rgb_matrix_neighbours_init();
+#endif
 
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    last_hit_clear(&last_hit_buffer);
+    last_hit_snapshot(&last_hit_buffer, &g_last_hit_tracker, g_last_hit_led, RGB_MATRIX_LED_COUNT);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
     eeconfig_init_rgb_matrix();
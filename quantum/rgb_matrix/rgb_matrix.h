@@ -24,6 +24,9 @@
 #include "rgb_matrix_drivers.h"
 #include "color.h"
 #include "keyboard.h"
+#ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+#    include "rgb_matrix_neighbours.h"
+#endif
 
 #ifndef RGB_MATRIX_TIMEOUT
 #    define RGB_MATRIX_TIMEOUT 0
@@ -111,8 +114,13 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
         rgb_matrix_set_color(i, r, g, b);          \
     }
 
-#define RGB_MATRIX_TEST_LED_FLAGS() \
-    if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+#    define RGB_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags) || !rgb_matrix_led_needs_render(i)) continue
+#else
+#    define RGB_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+#endif
 
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
@@ -159,6 +167,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
+// Next time rgb_matrix_task() has a frame to render, see keyboard_next_deadline()
+bool rgb_matrix_next_deadline(uint32_t *deadline);
 
 // This runs after another backlight effect and replaces
 // colors already set
@@ -220,6 +230,10 @@ void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 void        rgb_matrix_update_pwm_buffers(void);
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+bool rgb_matrix_led_needs_render(uint8_t index);
+#endif
+
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_force_flush_rgb_matrix
 #    define rgblight_reload_from_eeprom rgb_matrix_reload_from_eeprom
@@ -276,12 +290,36 @@ static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
 #endif
 }
 
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 8
+#endif
+
+// Colors queued by an effect, converted together with rgb_matrix_hsv_to_rgb_batch()
+typedef struct rgb_matrix_hsv_batch_t {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    hsv_t   hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} rgb_matrix_hsv_batch_t;
+
+void rgb_matrix_hsv_to_rgb_batch(const hsv_t *hsv, rgb_t *rgb, uint8_t count);
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch);
+
+static inline void rgb_matrix_hsv_batch_add(rgb_matrix_hsv_batch_t *batch, uint8_t index, hsv_t hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        rgb_matrix_hsv_batch_flush(batch);
+    }
+}
+
 extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+// Position of the most recent hit of each LED in g_last_hit_tracker, or LAST_HIT_NONE
+extern uint8_t g_last_hit_led[RGB_MATRIX_LED_COUNT];
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
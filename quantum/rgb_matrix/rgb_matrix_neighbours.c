@@ -0,0 +1,82 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "debug.h"
+#include <stdlib.h>
+#include <string.h>
+#include <lib/lib8tion/lib8tion.h>
+
+#ifdef RGB_MATRIX_NEIGHBOUR_TABLE
+
+#    if RGB_MATRIX_NEIGHBOUR_RADIUS > 255
+#        error "RGB_MATRIX_NEIGHBOUR_RADIUS must not exceed 255"
+#    endif
+
+static rgb_matrix_neighbour_t neighbours[RGB_MATRIX_NEIGHBOUR_TABLE_SIZE];
+static uint16_t               neighbour_start[RGB_MATRIX_LED_COUNT + 1];
+static bool                   neighbours_valid = false;
+
+static uint8_t point_distance(uint8_t a, uint8_t b) {
+    int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+    int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+bool rgb_matrix_neighbours_init(void) {
+    uint16_t size = 0;
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        neighbour_start[a] = size;
+        for (uint8_t b = 0; b < RGB_MATRIX_LED_COUNT; b++) {
+            if (a == b) continue;
+            int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+            int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+            if (abs(dx) > RGB_MATRIX_NEIGHBOUR_RADIUS || abs(dy) > RGB_MATRIX_NEIGHBOUR_RADIUS) continue;
+            uint8_t distance = point_distance(a, b);
+            if (distance > RGB_MATRIX_NEIGHBOUR_RADIUS) continue;
+            if (size == RGB_MATRIX_NEIGHBOUR_TABLE_SIZE) {
+                dprintf("rgb_matrix: neighbour table full at LED %u, increase RGB_MATRIX_NEIGHBOUR_TABLE_SIZE\n", a);
+                memset(neighbour_start, 0, sizeof(neighbour_start));
+                neighbours_valid = false;
+                return false;
+            }
+            neighbours[size++] = (rgb_matrix_neighbour_t){.index = b, .distance = distance};
+        }
+    }
+    neighbour_start[RGB_MATRIX_LED_COUNT] = size;
+    neighbours_valid                      = true;
+    return true;
+}
+
+bool rgb_matrix_neighbours_valid(void) {
+    return neighbours_valid;
+}
+
+const rgb_matrix_neighbour_t *rgb_matrix_neighbours(uint8_t led, uint8_t *count) {
+    *count = neighbour_start[led + 1] - neighbour_start[led];
+    return &neighbours[neighbour_start[led]];
+}
+
+uint8_t rgb_matrix_led_distance(uint8_t a, uint8_t b) {
+    if (a == b) {
+        return 0;
+    }
+
+    // neighbours are sorted by index
+    uint16_t lo = neighbour_start[a];
+    uint16_t hi = neighbour_start[a + 1];
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (neighbours[mid].index == b) {
+            return neighbours[mid].distance;
+        }
+        if (neighbours[mid].index < b) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return point_distance(a, b);
+}
+
+#endif // RGB_MATRIX_NEIGHBOUR_TABLE
@@ -0,0 +1,50 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+    Sparse table of the LEDs within RGB_MATRIX_NEIGHBOUR_RADIUS of each LED, with their
+    distances, built from g_led_config.point at init. Each LED's neighbours are sorted by
+    index and do not include the LED itself.
+*/
+
+#ifndef RGB_MATRIX_NEIGHBOUR_RADIUS
+#    define RGB_MATRIX_NEIGHBOUR_RADIUS 40
+#endif
+
+#ifndef RGB_MATRIX_NEIGHBOUR_TABLE_SIZE
+#    define RGB_MATRIX_NEIGHBOUR_TABLE_SIZE (RGB_MATRIX_LED_COUNT * 16)
+#endif
+
+typedef struct rgb_matrix_neighbour_t {
+    uint8_t index;
+    uint8_t distance;
+} rgb_matrix_neighbour_t;
+
+/**
+ * \brief Builds the table, needs to be called again if g_led_config.point changes.
+ *
+ * \return false if RGB_MATRIX_NEIGHBOUR_TABLE_SIZE is too small, the table is then left empty.
+ */
+bool rgb_matrix_neighbours_init(void);
+
+/**
+ * \brief Whether the table holds every LED pair within RGB_MATRIX_NEIGHBOUR_RADIUS.
+ */
+bool rgb_matrix_neighbours_valid(void);
+
+/**
+ * \brief Neighbours of an LED, `count` receives their number.
+ */
+const rgb_matrix_neighbour_t *rgb_matrix_neighbours(uint8_t led, uint8_t *count);
+
+/**
+ * \brief Distance between two LEDs, as sqrt16() of their squared distance.
+ *
+ * Pairs outside of the table are computed on the fly.
+ */
+uint8_t rgb_matrix_led_distance(uint8_t a, uint8_t b);
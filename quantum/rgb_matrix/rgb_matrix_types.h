@@ -22,26 +22,12 @@
 #include "compiler_support.h"
 #include "color.h"
 #include "util.h"
+#include "last_hit.h"
 
 #if defined(RGB_MATRIX_KEYPRESSES) || defined(RGB_MATRIX_KEYRELEASES)
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
-// Last led hit
-#ifndef LED_HITS_TO_REMEMBER
-#    define LED_HITS_TO_REMEMBER 8
-#endif // LED_HITS_TO_REMEMBER
-
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-typedef struct PACKED {
-    uint8_t  count;
-    uint8_t  x[LED_HITS_TO_REMEMBER];
-    uint8_t  y[LED_HITS_TO_REMEMBER];
-    uint8_t  index[LED_HITS_TO_REMEMBER];
-    uint16_t tick[LED_HITS_TO_REMEMBER];
-} last_hit_t;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
-
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -0,0 +1,216 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "mock_loopback.h"
+#include "serial.h"
+#include "transactions.h"
+#include "transport.h"
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
+
+// The transport keeps a single shared memory image, the loopback swaps the
+// master and slave views in and out of it around every transaction.
+static split_shared_memory_t master_image;
+static split_shared_memory_t slave_image;
+
+static int8_t  transaction_ids[LOOPBACK_MAX_TRANSACTIONS];
+static uint8_t transaction_count;
+
+loopback_slave_t loopback_slave;
+uint8_t          loopback_master_led_state;
+uint8_t          loopback_master_mods;
+bool             loopback_link_ok;
+int16_t          loopback_corrupt_offset;
+int8_t           loopback_lost_reply;
+
+static bool on_slave = false;
+
+#define LOOPBACK_ASYNC_QUEUE_SIZE 2
+
+static int     async_index[LOOPBACK_ASYNC_QUEUE_SIZE];
+static bool    async_okay[LOOPBACK_ASYNC_QUEUE_SIZE];
+static uint8_t async_queued = 0;
+static uint8_t async_done   = 0;
+static uint8_t async_taken  = 0;
+#ifdef PROFILER_ENABLE
+static uint32_t async_queued_at[LOOPBACK_ASYNC_QUEUE_SIZE];
+static uint32_t async_done_at[LOOPBACK_ASYNC_QUEUE_SIZE];
+#endif
+
+void loopback_reset(void) {
+    memset(split_shmem, 0, sizeof(split_shared_memory_t));
+    memset(&slave_image, 0, sizeof(slave_image));
+    memset(&loopback_slave, 0, sizeof(loopback_slave));
+    loopback_master_led_state = 0;
+    loopback_master_mods      = 0;
+    loopback_link_ok          = true;
+    loopback_corrupt_offset   = -1;
+    loopback_lost_reply       = -1;
+    async_queued              = 0;
+    async_done                = 0;
+    async_taken               = 0;
+    loopback_clear_transactions();
+}
+
+void loopback_clear_transactions(void) {
+    transaction_count = 0;
+}
+
+void loopback_run_slave(matrix_row_t slave_matrix[]) {
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+
+    memcpy(&master_image, split_shmem, sizeof(master_image));
+    memcpy(split_shmem, &slave_image, sizeof(slave_image));
+    on_slave = true;
+    transactions_slave(master_matrix, slave_matrix);
+    on_slave = false;
+    memcpy(&slave_image, split_shmem, sizeof(slave_image));
+    memcpy(split_shmem, &master_image, sizeof(master_image));
+}
+
+uint8_t loopback_transaction_count(void) {
+    return transaction_count;
+}
+
+int8_t loopback_transaction_id(uint8_t index) {
+    return index < transaction_count ? transaction_ids[index] : -1;
+}
+
+// Completes the transactions queued on the transport thread, if any
+bool loopback_run_async(void) {
+    if (async_done >= async_queued) {
+        return false;
+    }
+    while (async_done < async_queued) {
+        async_okay[async_done] = soft_serial_transaction(async_index[async_done]);
+#ifdef PROFILER_ENABLE
+        async_done_at[async_done] = profiler_read_counter();
+#endif
+        async_done++;
+    }
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+bool soft_serial_async_transaction(int sstd_index) {
+    if (async_queued >= LOOPBACK_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+#    ifdef PROFILER_ENABLE
+    async_queued_at[async_queued] = profiler_read_counter();
+#    endif
+    async_index[async_queued++] = sstd_index;
+    return true;
+}
+
+bool soft_serial_async_busy(void) {
+    return async_done < async_queued;
+}
+
+bool soft_serial_async_result(uint32_t *ticks) {
+    *ticks = 0;
+    if (soft_serial_async_busy() || async_taken >= async_queued) {
+        return false;
+    }
+#    ifdef PROFILER_ENABLE
+    *ticks = async_done_at[async_taken] - async_queued_at[async_taken];
+#    endif
+    bool okay = async_okay[async_taken++];
+    if (async_taken == async_queued) {
+        async_queued = 0;
+        async_done   = 0;
+        async_taken  = 0;
+    }
+    return okay;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int sstd_index) {
+    split_transaction_desc_t *trans = &split_transaction_table[sstd_index];
+
+    if (transaction_count < LOOPBACK_MAX_TRANSACTIONS) {
+        transaction_ids[transaction_count] = sstd_index;
+    }
+    transaction_count++;
+    if (!loopback_link_ok) {
+        return false;
+    }
+
+    // Initiator to target buffer travels to the slave
+    memcpy(&master_image, split_shmem, sizeof(master_image));
+    memcpy(split_shmem, &slave_image, sizeof(slave_image));
+    memcpy(split_trans_initiator2target_buffer(trans), ((uint8_t *)&master_image) + trans->initiator2target_offset, trans->initiator2target_buffer_size);
+    if (loopback_corrupt_offset >= 0 && loopback_corrupt_offset < trans->initiator2target_buffer_size) {
+        split_trans_initiator2target_buffer(trans)[loopback_corrupt_offset] ^= 0xFF;
+        loopback_corrupt_offset = -1;
+    }
+    if (trans->slave_callback) {
+        on_slave = true;
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        on_slave = false;
+    }
+
+    // Target to initiator buffer travels back to the master
+    memcpy(((uint8_t *)&master_image) + trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    memcpy(&slave_image, split_shmem, sizeof(slave_image));
+    memcpy(split_shmem, &master_image, sizeof(master_image));
+    if (loopback_lost_reply == sstd_index) {
+        loopback_lost_reply = -1;
+        return false;
+    }
+    return true;
+}
+
+bool is_keyboard_master(void) {
+    return !on_slave;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+uint8_t host_keyboard_leds(void) {
+    return loopback_master_led_state;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    loopback_slave.led_state = led_state;
+}
+
+uint8_t get_mods(void) {
+    return loopback_master_mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+
+uint8_t get_oneshot_mods(void) {
+    return 0;
+}
+
+uint8_t get_oneshot_locked_mods(void) {
+    return 0;
+}
+
+void set_mods(uint8_t mods) {
+    loopback_slave.mods = mods;
+}
+
+void set_weak_mods(uint8_t mods) {
+    loopback_slave.weak_mods = mods;
+}
+
+void set_oneshot_mods(uint8_t mods) {
+    loopback_slave.oneshot_mods = mods;
+}
+
+void set_oneshot_locked_mods(uint8_t mods) {
+    loopback_slave.oneshot_locked_mods = mods;
+}
@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+
+#define LOOPBACK_MAX_TRANSACTIONS 32
+
+// State of the simulated slave half.
+typedef struct loopback_slave_t {
+    uint8_t led_state;
+    uint8_t mods;
+    uint8_t weak_mods;
+    uint8_t oneshot_mods;
+    uint8_t oneshot_locked_mods;
+} loopback_slave_t;
+
+extern loopback_slave_t loopback_slave;
+extern uint8_t          loopback_master_led_state;
+extern uint8_t          loopback_master_mods;
+extern bool             loopback_link_ok;
+extern int16_t          loopback_corrupt_offset; // flips this byte of the next write, -1 for none
+extern int8_t           loopback_lost_reply;     // the next reply to this transaction never arrives, -1 for none
+
+void    loopback_reset(void);
+void    loopback_clear_transactions(void);
+void    loopback_run_slave(matrix_row_t slave_matrix[]);
+uint8_t loopback_transaction_count(void);
+int8_t  loopback_transaction_id(uint8_t index);
+bool    loopback_run_async(void);
@@ -0,0 +1,29 @@
+split_transport_DEFS := -DNO_PRINT -DSPLIT_TRANSPORT_STATS
+split_transport_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_loopback.h
+split_transport_INC := $(QUANTUM_PATH)/split_common $(QUANTUM_PATH)/split_common/tests
+
+split_transport_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_tests.cpp
+
+split_transport_batch_DEFS := $(split_transport_DEFS) -DSPLIT_TRANSACTION_BATCH
+split_transport_batch_CONFIG := $(split_transport_CONFIG)
+split_transport_batch_INC := $(split_transport_INC)
+split_transport_batch_SRC := $(split_transport_SRC)
+
+split_transport_delta_DEFS := $(split_transport_DEFS) -DSPLIT_MATRIX_DELTA
+split_transport_delta_CONFIG := $(split_transport_CONFIG)
+split_transport_delta_INC := $(split_transport_INC)
+split_transport_delta_SRC := $(split_transport_SRC)
+
+split_transport_async_DEFS := $(split_transport_DEFS) -DSPLIT_TRANSPORT_ASYNC -DPROFILER_ENABLE
+split_transport_async_CONFIG := $(split_transport_CONFIG)
+split_transport_async_INC := $(split_transport_INC)
+split_transport_async_SRC := $(split_transport_SRC) \
+	$(QUANTUM_PATH)/profiler.c
@@ -0,0 +1,284 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transactions.h"
+#include "transport.h"
+#include "timer.h"
+#include "split_common/tests/mock_loopback.h"
+
+void advance_time(uint32_t ms);
+}
+
+class SplitTransport : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2]  = {0};
+    matrix_row_t received[(MATRIX_ROWS) / 2]      = {0};
+
+    void SetUp() override {
+        loopback_reset();
+        transport_master_init();
+        // Settle both halves with a forced sync so every test starts from the same state
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        scan();
+        loopback_clear_transactions();
+        split_transport_reset_stats();
+    }
+
+    bool scan() {
+        loopback_run_slave(slave_matrix);
+        bool okay = transactions_master(master_matrix, received);
+        loopback_run_slave(slave_matrix);
+        return okay;
+    }
+
+    uint32_t serial_bytes(int8_t id) {
+        return sizeof(int8_t) + split_transaction_table[id].initiator2target_buffer_size + split_transaction_table[id].target2initiator_buffer_size;
+    }
+};
+
+TEST_F(SplitTransport, IdleScanOnlyReadsTheChecksum) {
+    EXPECT_TRUE(scan());
+    ASSERT_EQ(loopback_transaction_count(), 1);
+    EXPECT_EQ(loopback_transaction_id(0), GET_SLAVE_MATRIX_CHECKSUM);
+
+    const split_transport_stats_t *stats = split_transport_get_stats();
+    EXPECT_EQ(stats->scans, 1u);
+    EXPECT_EQ(stats->transactions, 1u);
+    EXPECT_EQ(stats->bytes, serial_bytes(GET_SLAVE_MATRIX_CHECKSUM));
+}
+
+TEST_F(SplitTransport, SlaveMatrixIsReceived) {
+    slave_matrix[2] = 0x81;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received[2], 0x81);
+    EXPECT_EQ(loopback_transaction_count(), 2);
+#ifdef SPLIT_MATRIX_DELTA
+    EXPECT_EQ(loopback_transaction_id(1), GET_SLAVE_MATRIX_DELTA);
+    EXPECT_EQ(split_transport_get_stats()->matrix_deltas, 1u);
+#else
+    EXPECT_EQ(loopback_transaction_id(1), GET_SLAVE_MATRIX_DATA);
+#endif
+}
+
+#ifdef SPLIT_MATRIX_DELTA
+TEST_F(SplitTransport, TooManyChangedRowsFallBackToFullRead) {
+    for (uint8_t row = 0; row <= SPLIT_MATRIX_DELTA_ROWS; row++) {
+        slave_matrix[row] = 1 << row;
+    }
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(memcmp(received, slave_matrix, sizeof(received)), 0);
+    ASSERT_EQ(loopback_transaction_count(), 3);
+    EXPECT_EQ(loopback_transaction_id(1), GET_SLAVE_MATRIX_DELTA);
+    EXPECT_EQ(loopback_transaction_id(2), GET_SLAVE_MATRIX_DATA);
+    EXPECT_EQ(split_transport_get_stats()->matrix_full, 1u);
+}
+
+TEST_F(SplitTransport, LostDeltaIsRecovered) {
+    // The slave moves its delta base on, the retry then sees an empty delta
+    // that does not match the checksum and reads the full matrix
+    slave_matrix[1]     = 0x10;
+    loopback_lost_reply = GET_SLAVE_MATRIX_DELTA;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(memcmp(received, slave_matrix, sizeof(received)), 0);
+    EXPECT_EQ(split_transport_get_stats()->matrix_full, 1u);
+}
+#endif // SPLIT_MATRIX_DELTA
+
+TEST_F(SplitTransport, DirtyStateReachesTheSlave) {
+    loopback_master_led_state = 0x02;
+    loopback_master_mods      = 0x05;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.led_state, 0x02);
+    EXPECT_EQ(loopback_slave.mods, 0x05);
+
+    const split_transport_stats_t *stats = split_transport_get_stats();
+#ifdef SPLIT_TRANSACTION_BATCH
+    // Matrix checksum, then both writes in a single batch
+    ASSERT_EQ(loopback_transaction_count(), 2);
+    EXPECT_EQ(loopback_transaction_id(1), PUT_BATCH);
+    EXPECT_EQ(stats->bytes, serial_bytes(GET_SLAVE_MATRIX_CHECKSUM) + serial_bytes(PUT_BATCH));
+#else
+    ASSERT_EQ(loopback_transaction_count(), 3);
+    EXPECT_EQ(loopback_transaction_id(1), PUT_LED_STATE);
+    EXPECT_EQ(loopback_transaction_id(2), PUT_MODS);
+    EXPECT_EQ(stats->bytes, serial_bytes(GET_SLAVE_MATRIX_CHECKSUM) + serial_bytes(PUT_LED_STATE) + serial_bytes(PUT_MODS));
+#endif
+    EXPECT_EQ(stats->transactions, loopback_transaction_count());
+    EXPECT_EQ(split_transport_bytes_per_scan(), stats->bytes);
+}
+
+TEST_F(SplitTransport, ForcedSyncCostsOneTurnaroundForAllWrites) {
+    loopback_master_mods = 0x01;
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x01);
+#ifdef SPLIT_TRANSACTION_BATCH
+    // Matrix checksum and data, then sync timer, LED state and mods in one batch
+    EXPECT_EQ(loopback_transaction_count(), 3);
+#else
+    EXPECT_EQ(loopback_transaction_count(), 5);
+#endif
+}
+
+TEST_F(SplitTransport, FailedTransactionsAreCounted) {
+    loopback_link_ok = false;
+    EXPECT_FALSE(scan());
+
+    const split_transport_stats_t *stats = split_transport_get_stats();
+    EXPECT_EQ(stats->scans, 1u);
+    EXPECT_GT(stats->failed, 0u);
+    EXPECT_EQ(stats->failed, stats->transactions);
+}
+
+#ifdef SPLIT_TRANSACTION_BATCH
+TEST_F(SplitTransport, CorruptBatchIsSentAgain) {
+    loopback_corrupt_offset = offsetof(split_batch_sync_t, records);
+    loopback_master_mods    = 0x08;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x08);
+
+    // Matrix checksum, then the rejected batch and its retry
+    ASSERT_EQ(loopback_transaction_count(), 3);
+    EXPECT_EQ(loopback_transaction_id(1), PUT_BATCH);
+    EXPECT_EQ(loopback_transaction_id(2), PUT_BATCH);
+}
+
+TEST_F(SplitTransport, BatchWithLostAcknowledgementIsSentAgain) {
+    loopback_lost_reply  = PUT_BATCH;
+    loopback_master_mods = 0x10;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x10);
+    EXPECT_EQ(loopback_transaction_count(), 3);
+}
+
+TEST_F(SplitTransport, BatchAfterMasterRestartIsApplied) {
+    loopback_master_mods = 0x01;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x01);
+
+    // The master starts over while the slave keeps the sequence number of the last batch
+    transport_master_init();
+    loopback_master_mods = 0x02;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x02);
+    loopback_master_mods = 0x04;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(loopback_slave.mods, 0x04);
+}
+
+TEST_F(SplitTransport, WritesOutsideTheScanAreNotBatched) {
+    uint8_t led_state = 0x04;
+    EXPECT_TRUE(transport_execute_transaction(PUT_LED_STATE, &led_state, sizeof(led_state), NULL, 0));
+    ASSERT_EQ(loopback_transaction_count(), 1);
+    EXPECT_EQ(loopback_transaction_id(0), PUT_LED_STATE);
+}
+#endif // SPLIT_TRANSACTION_BATCH
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+TEST_F(SplitTransport, AsyncScanDoesNotWaitForTheSlave) {
+    matrix_row_t slave_view[(MATRIX_ROWS) / 2] = {0};
+
+    slave_matrix[0] = 0x42;
+    loopback_run_slave(slave_matrix);
+
+    // The first scan only queues the slave matrix read
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_EQ(loopback_transaction_count(), 0);
+
+    // Scans keep going with the last known slave state while it runs
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_EQ(slave_view[0], 0);
+    EXPECT_EQ(split_transport_get_stats()->async_pending, 1u);
+
+    // The transport thread only moves the bytes, the next scan checks and uses them
+    EXPECT_TRUE(loopback_run_async());
+    ASSERT_EQ(loopback_transaction_count(), 1);
+    EXPECT_EQ(loopback_transaction_id(0), GET_SLAVE_MATRIX_ASYNC);
+    EXPECT_EQ(slave_view[0], 0);
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_EQ(slave_view[0], 0x42);
+    EXPECT_TRUE(loopback_run_async());
+}
+
+TEST_F(SplitTransport, AsyncWritesRunOnTheTransportThread) {
+    matrix_row_t slave_view[(MATRIX_ROWS) / 2] = {0};
+
+    loopback_master_mods = 0x05;
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_EQ(loopback_transaction_count(), 0);
+
+    // The batched writes go out first, then the slave matrix read
+    EXPECT_TRUE(loopback_run_async());
+    ASSERT_EQ(loopback_transaction_count(), 2);
+    EXPECT_EQ(loopback_transaction_id(0), PUT_BATCH);
+    EXPECT_EQ(loopback_transaction_id(1), GET_SLAVE_MATRIX_ASYNC);
+    loopback_run_slave(slave_matrix);
+    EXPECT_EQ(loopback_slave.mods, 0x05);
+
+    // The acknowledgement is checked by the next scan, without anything else going over the wire
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_EQ(loopback_transaction_count(), 2);
+    EXPECT_TRUE(loopback_run_async());
+}
+
+TEST_F(SplitTransport, AsyncBatchWithLostAcknowledgementIsSentAgain) {
+    matrix_row_t slave_view[(MATRIX_ROWS) / 2] = {0};
+
+    loopback_lost_reply  = PUT_BATCH;
+    loopback_master_mods = 0x0A;
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_TRUE(loopback_run_async());
+
+    // The next scan sends the same batch again before anything else, the slave only applies it once
+    loopback_master_mods = 0;
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    ASSERT_GE(loopback_transaction_count(), 3);
+    EXPECT_EQ(loopback_transaction_id(2), PUT_BATCH);
+    EXPECT_TRUE(loopback_run_async());
+    loopback_run_slave(slave_matrix);
+    EXPECT_EQ(loopback_slave.mods, 0);
+}
+
+TEST_F(SplitTransport, AsyncFailureIsReportedOnce) {
+    matrix_row_t slave_view[(MATRIX_ROWS) / 2] = {0};
+
+    loopback_link_ok = false;
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_TRUE(loopback_run_async());
+    loopback_link_ok = true;
+
+    EXPECT_FALSE(transport_master(master_matrix, slave_view));
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    EXPECT_TRUE(loopback_run_async());
+}
+
+#    ifdef PROFILER_ENABLE
+TEST_F(SplitTransport, AsyncLatencyCoversTheRoundTrip) {
+    matrix_row_t slave_view[(MATRIX_ROWS) / 2] = {0};
+
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+    usleep(2000);
+    EXPECT_TRUE(loopback_run_async());
+    EXPECT_TRUE(transport_master(master_matrix, slave_view));
+
+    const split_transaction_latency_t *latency = &split_transport_get_stats()->transaction_latency[GET_SLAVE_MATRIX_ASYNC];
+    EXPECT_EQ(latency->count, 1u);
+    EXPECT_GE(latency->max_us, 2000u);
+    EXPECT_TRUE(loopback_run_async());
+}
+#    endif // PROFILER_ENABLE
+#endif // SPLIT_TRANSPORT_ASYNC
+
+TEST_F(SplitTransport, LatencyIsTrackedPerTransaction) {
+    EXPECT_TRUE(scan());
+    const split_transport_stats_t *stats = split_transport_get_stats();
+    EXPECT_EQ(stats->transaction_latency[GET_SLAVE_MATRIX_CHECKSUM].count, 1u);
+    EXPECT_EQ(stats->transaction_latency[GET_SLAVE_MATRIX_DATA].count, 0u);
+    EXPECT_EQ(split_transport_transaction_latency_us(-1), 0u);
+}
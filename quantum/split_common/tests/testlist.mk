@@ -0,0 +1,5 @@
+TEST_LIST += \
+	split_transport \
+	split_transport_async \
+	split_transport_batch \
+	split_transport_delta
@@ -18,6 +18,11 @@
 
 #include "compiler_support.h"
 
+#if defined(SPLIT_TRANSPORT_ASYNC) && !defined(SPLIT_TRANSACTION_BATCH)
+// The writes of each scan go to the transport thread as a single batch
+#    define SPLIT_TRANSACTION_BATCH
+#endif // defined(SPLIT_TRANSPORT_ASYNC) && !defined(SPLIT_TRANSACTION_BATCH)
+
 enum serial_transaction_id {
 #ifdef USE_I2C
     I2C_EXECUTE_CALLBACK,
@@ -26,6 +31,14 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_MATRIX_DELTA
+    GET_SLAVE_MATRIX_DELTA,
+#endif // SPLIT_MATRIX_DELTA
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    GET_SLAVE_MATRIX_ASYNC,
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -99,6 +112,10 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    PUT_BATCH,
+#endif // SPLIT_TRANSACTION_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
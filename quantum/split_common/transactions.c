@@ -19,6 +19,7 @@
 #include <stddef.h>
 
 #include "crc.h"
+#include "util.h"
 #include "debug.h"
 #include "matrix.h"
 #include "host.h"
@@ -64,6 +65,9 @@
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
 
 #define SYNC_TIMER_OFFSET 2
 
@@ -84,9 +88,18 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BATCH
+static bool transaction_batch_write(int8_t id, const void *data, uint16_t length);
+#    define transport_write(id, data, length) transaction_batch_write(id, data, length)
+#    define transport_exec(id) transaction_batch_write(id, NULL, 0)
+static bool transaction_batch_execute(int8_t id, const void *data, uint16_t length);
+#    define transport_exec_now(id) transaction_batch_execute(id, NULL, 0)
+#else
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#    define transport_exec_now(id) transport_exec(id)
+#endif // SPLIT_TRANSACTION_BATCH
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -144,6 +157,190 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+static split_batch_sync_t batch;
+static bool               batch_open              = false;
+static bool               batch_restarted         = true;
+static uint8_t            batch_sync_timer_offset = 0;
+
+// Fills in the parts of the batch which depend on when it goes out.
+static void batch_prepare(void) {
+#    ifndef DISABLE_SYNC_TIMER
+    // The sync timer is sampled when the batch goes out, not when it was queued
+    if (batch_sync_timer_offset) {
+        uint32_t sync_timer = sync_timer_read32() + SYNC_TIMER_OFFSET;
+        memcpy(&batch.records[batch_sync_timer_offset], &sync_timer, sizeof(sync_timer));
+    }
+#    endif // DISABLE_SYNC_TIMER
+    batch.checksum = crc8(&batch.sequence, sizeof(batch.sequence) + batch.length);
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_prepare();
+
+    uint8_t ack  = SPLIT_BATCH_SEQUENCE_NACK;
+    bool    okay = transport_execute_transaction(PUT_BATCH, &batch, offsetof(split_batch_sync_t, records) + batch.length, &ack, sizeof(ack));
+    return okay && ack == batch.sequence;
+}
+
+static void batch_next_sequence(void) {
+    // The slave may still hold any sequence number from before the master restarted
+    if (batch_restarted) {
+        batch_restarted = false;
+        batch.sequence  = SPLIT_BATCH_SEQUENCE_RESTART;
+        return;
+    }
+    batch.sequence = batch.sequence + 1 >= SPLIT_BATCH_SEQUENCE_NACK ? SPLIT_BATCH_SEQUENCE_RESTART + 1 : batch.sequence + 1;
+}
+
+// Sends the queued writes, retrying until the slave acknowledges the batch.
+static bool transaction_batch_flush(void) {
+    if (batch.length == 0) {
+        return true;
+    }
+    batch_next_sequence();
+
+    bool okay               = transaction_handler_master(NULL, NULL, "batch", &batch_handlers_master);
+    batch.length            = 0;
+    batch_sync_timer_offset = 0;
+    return okay;
+}
+
+// Executes a write outside of the batch, after the writes queued before it.
+static bool transaction_batch_execute(int8_t id, const void *data, uint16_t length) {
+    if (!transaction_batch_flush()) {
+        return false;
+    }
+    return transport_execute_transaction(id, data, length, NULL, 0);
+}
+
+// Queues a master to slave write until the end of the scan, writes that
+// expect a reply or do not fit are executed straight away.
+static bool transaction_batch_write(int8_t id, const void *data, uint16_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!batch_open || trans->target2initiator_buffer_size > 0 || 1 + trans->initiator2target_buffer_size > sizeof(batch.records)) {
+        return transaction_batch_execute(id, data, length);
+    }
+    if (batch.length + 1 + trans->initiator2target_buffer_size > sizeof(batch.records) && !transaction_batch_flush()) {
+        return false;
+    }
+    if (length > 0) {
+        memcpy(split_trans_initiator2target_buffer(trans), data, MIN(length, trans->initiator2target_buffer_size));
+    }
+    batch.records[batch.length++] = id;
+#    ifndef DISABLE_SYNC_TIMER
+    if (id == PUT_SYNC_TIMER) {
+        batch_sync_timer_offset = batch.length;
+    }
+#    endif // DISABLE_SYNC_TIMER
+    memcpy(&batch.records[batch.length], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    batch.length += trans->initiator2target_buffer_size;
+    return true;
+}
+
+static void batch_handlers_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint8_t            last_sequence = SPLIT_BATCH_SEQUENCE_RESTART;
+    const split_batch_sync_t *received      = (const split_batch_sync_t *)initiator2target_buffer;
+    uint8_t                  *ack           = (uint8_t *)target2initiator_buffer;
+
+    if (received->length > sizeof(received->records) || received->checksum != crc8(&received->sequence, sizeof(received->sequence) + received->length)) {
+        *ack = SPLIT_BATCH_SEQUENCE_NACK;
+        return;
+    }
+    *ack = received->sequence;
+
+    // A retry of a batch that was applied but whose acknowledgement got lost,
+    // unless the master restarted: its writes are applied again then
+    if (received->sequence != SPLIT_BATCH_SEQUENCE_RESTART && received->sequence == last_sequence) {
+        return;
+    }
+    last_sequence = received->sequence;
+
+    for (uint8_t i = 0; i < received->length;) {
+        int8_t id = received->records[i++];
+        if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || id == PUT_BATCH) {
+            return;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (i + trans->initiator2target_buffer_size > received->length) {
+            return;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &received->records[i], trans->initiator2target_buffer_size);
+        i += trans->initiator2target_buffer_size;
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+}
+
+static void transaction_batch_begin(void) {
+    batch.length            = 0;
+    batch_sync_timer_offset = 0;
+    batch_open              = true;
+}
+
+static bool transaction_batch_end(void) {
+    batch_open = false;
+    return transaction_batch_flush();
+}
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+
+static bool batch_async_pending = false;
+
+// Hands the queued writes to the transport thread instead of waiting for the
+// acknowledgement, which is checked by transaction_batch_async_finish().
+static bool transaction_batch_async_end(void) {
+    batch_open = false;
+    if (batch.length == 0) {
+        return true;
+    }
+    batch_next_sequence();
+    batch_prepare();
+    memcpy(&split_shmem->batch, &batch, sizeof(batch));
+    split_shmem->batch_ack = SPLIT_BATCH_SEQUENCE_NACK;
+    batch_async_pending    = transport_async_start(PUT_BATCH);
+    if (!batch_async_pending) {
+        return transaction_handler_master(NULL, NULL, "batch", &batch_handlers_master);
+    }
+    return true;
+}
+
+// Checks the acknowledgement of the batch sent on the transport thread, and
+// sends it again from the main loop if the slave did not apply it.
+static bool transaction_batch_async_finish(void) {
+    if (!batch_async_pending) {
+        return true;
+    }
+    batch_async_pending = false;
+    bool okay           = transport_async_finish(PUT_BATCH);
+    if (okay && split_shmem->batch_ack == batch.sequence) {
+        return true;
+    }
+    return transaction_handler_master(NULL, NULL, "batch", &batch_handlers_master);
+}
+
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_BEGIN() transaction_batch_begin()
+#    define TRANSACTIONS_BATCH_END() transaction_batch_end()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [PUT_BATCH] = { sizeof_member(split_shared_memory_t, batch), offsetof(split_shared_memory_t, batch), sizeof_member(split_shared_memory_t, batch_ack), offsetof(split_shared_memory_t, batch_ack), batch_handlers_slave_callback },
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_BEGIN()
+#    define TRANSACTIONS_BATCH_END() true
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
@@ -178,12 +375,68 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_DELTA
+
+// Applies the changed rows on top of the last received matrix, returns false
+// if the rows did not fit in the delta or the result does not match the slave.
+static bool apply_slave_matrix_delta(const split_slave_matrix_delta_t *delta, matrix_row_t matrix[]) {
+    uint8_t count = 0;
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        if (delta->changed[row / 8] & (1 << (row % 8))) {
+            if (count >= SPLIT_MATRIX_DELTA_ROWS) {
+                return false;
+            }
+            matrix[row] = delta->rows[count++];
+        }
+    }
+    return delta->checksum == crc8(matrix, sizeof(split_shmem->smatrix.matrix));
+}
+
+static bool read_slave_matrix(uint32_t *last_update, matrix_row_t destination[]) {
+    matrix_row_t *equiv_shmem = split_shmem->smatrix.matrix;
+    size_t        length      = sizeof(split_shmem->smatrix.matrix);
+    uint8_t       curr_checksum;
+    bool          okay = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &curr_checksum, sizeof(curr_checksum));
+    bool          full = timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS;
+    if (okay && !full && curr_checksum != crc8(equiv_shmem, length)) {
+        split_slave_matrix_delta_t delta;
+        if (!transport_read(GET_SLAVE_MATRIX_DELTA, &delta, sizeof(delta))) {
+            return false;
+        }
+        if (apply_slave_matrix_delta(&delta, equiv_shmem)) {
+            split_transport_stats_record_matrix(true);
+            memcpy(destination, equiv_shmem, length);
+            return true;
+        }
+        // Too many rows changed, or a previous delta went missing
+        curr_checksum = delta.checksum;
+        full          = true;
+    }
+    if (okay && (full || curr_checksum != crc8(equiv_shmem, length))) {
+        okay &= transport_read(GET_SLAVE_MATRIX_DATA, destination, length);
+        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay) {
+            split_transport_stats_record_matrix(false);
+            *last_update = timer_read32();
+        }
+    } else {
+        memcpy(destination, equiv_shmem, length);
+    }
+    return okay;
+}
+
+#endif // SPLIT_MATRIX_DELTA
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
+#ifdef SPLIT_MATRIX_DELTA
+    bool okay = read_slave_matrix(&last_update, temp_matrix);
+#else
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#endif // SPLIT_MATRIX_DELTA
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
         memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
@@ -198,12 +451,81 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+#ifdef SPLIT_MATRIX_DELTA
+
+static void slave_matrix_delta_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static matrix_row_t         delta_base[(MATRIX_ROWS) / 2] = {0}; // matrix as of the previous delta
+    split_slave_matrix_delta_t *delta                         = &split_shmem->smatrix.delta;
+    uint8_t                     count                         = 0;
+
+    memset(delta->changed, 0, sizeof(delta->changed));
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        if (split_shmem->smatrix.matrix[row] != delta_base[row]) {
+            delta->changed[row / 8] |= 1 << (row % 8);
+            if (count < SPLIT_MATRIX_DELTA_ROWS) {
+                delta->rows[count] = split_shmem->smatrix.matrix[row];
+            }
+            count++;
+        }
+    }
+    delta->checksum = split_shmem->smatrix.checksum;
+    // Either the master applies every changed row or it falls back to a full read
+    memcpy(delta_base, split_shmem->smatrix.matrix, sizeof(delta_base));
+}
+
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS [GET_SLAVE_MATRIX_DELTA] = trans_target2initiator_initializer_cb(smatrix.delta, slave_matrix_delta_slave_callback),
+
+#else // SPLIT_MATRIX_DELTA
+
+#    define TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS
+
+#endif // SPLIT_MATRIX_DELTA
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+static matrix_row_t slave_matrix_async_last[(MATRIX_ROWS) / 2] = {0};
+static bool         slave_matrix_async_pending                 = false;
+
+// The bytes of the slave matrix read move on the transport thread, its result
+// is checked here on the main loop once the transfer has finished.
+static bool slave_matrix_async_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay = true;
+    if (slave_matrix_async_pending) {
+        slave_matrix_async_pending = false;
+        okay                       = transport_async_finish(GET_SLAVE_MATRIX_ASYNC);
+        okay &= split_shmem->smatrix.checksum == crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+        if (okay) {
+            split_transport_stats_record_matrix(false);
+            memcpy(slave_matrix_async_last, split_shmem->smatrix.matrix, sizeof(slave_matrix_async_last));
+        }
+    }
+    memcpy(slave_matrix, slave_matrix_async_last, sizeof(slave_matrix_async_last));
+    return okay;
+}
+
+// Queues the next read behind the batched writes of this synchronisation, so
+// that the matrix is as recent as possible when the main loop picks it up
+static void slave_matrix_async_start(void) {
+    slave_matrix_async_pending = transport_async_start(GET_SLAVE_MATRIX_ASYNC);
+}
+
+#    define TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS \
+        [GET_SLAVE_MATRIX_ASYNC] = { 0, 0, offsetof(split_slave_matrix_sync_t, matrix) + sizeof_member(split_slave_matrix_sync_t, matrix), offsetof(split_shared_memory_t, smatrix), NULL },
+
+#else // SPLIT_TRANSPORT_ASYNC
+
+#    define TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_DELTA_REGISTRATIONS \
+    TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -255,7 +577,7 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
             }
 
             if (actioned) {
-                okay &= transport_exec(CMD_ENCODER_DRAIN);
+                okay &= transport_exec_now(CMD_ENCODER_DRAIN);
             }
             last_checksum = split_shmem->encoders.checksum;
         }
@@ -944,6 +1266,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -954,8 +1277,80 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_STATS
+
+static split_transport_stats_t transport_stats = {.latency_min_us = UINT32_MAX};
+
+const split_transport_stats_t *split_transport_get_stats(void) {
+    return &transport_stats;
+}
+
+void split_transport_reset_stats(void) {
+    memset(&transport_stats, 0, sizeof(transport_stats));
+    transport_stats.latency_min_us = UINT32_MAX;
+}
+
+uint32_t split_transport_bytes_per_scan(void) {
+    return transport_stats.scans ? transport_stats.bytes / transport_stats.scans : 0;
+}
+
+uint32_t split_transport_average_latency_us(void) {
+    return transport_stats.scans ? (uint32_t)(transport_stats.latency_total_us / transport_stats.scans) : 0;
+}
+
+uint32_t split_transport_transaction_latency_us(int8_t id) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS || !transport_stats.transaction_latency[id].count) {
+        return 0;
+    }
+    return transport_stats.transaction_latency[id].total_us / transport_stats.transaction_latency[id].count;
+}
+
+void split_transport_stats_record_transaction(int8_t id, uint16_t bytes, uint32_t latency_us, bool okay) {
+    transport_stats.transactions++;
+    transport_stats.bytes += bytes;
+    if (!okay) {
+        transport_stats.failed++;
+    }
+
+    split_transaction_latency_t *latency = &transport_stats.transaction_latency[id];
+    latency->count++;
+    latency->total_us += latency_us;
+    if (latency_us > latency->max_us) {
+        latency->max_us = latency_us;
+    }
+}
+
+void split_transport_stats_record_pending(void) {
+    transport_stats.async_pending++;
+}
+
+void split_transport_stats_record_matrix(bool delta) {
+    if (delta) {
+        transport_stats.matrix_deltas++;
+    } else {
+        transport_stats.matrix_full++;
+    }
+}
+
+static void split_transport_stats_record_scan(uint32_t latency_us) {
+    transport_stats.scans++;
+    transport_stats.latency_total_us += latency_us;
+    if (latency_us < transport_stats.latency_min_us) {
+        transport_stats.latency_min_us = latency_us;
+    }
+    if (latency_us > transport_stats.latency_max_us) {
+        transport_stats.latency_max_us = latency_us;
+    }
+}
+
+#endif // SPLIT_TRANSPORT_STATS
+
+static bool slave_matrix_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    return true;
+}
+
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
@@ -977,6 +1372,59 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+static bool transactions_master_run(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], bool (*slave_matrix_handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]), bool async) {
+#if defined(SPLIT_TRANSPORT_STATS) && defined(PROFILER_ENABLE)
+    uint32_t start = profiler_read_counter();
+#endif
+    TRANSACTIONS_BATCH_BEGIN();
+    bool okay = slave_matrix_handler(master_matrix, slave_matrix) && transactions_master_handlers(master_matrix, slave_matrix);
+#ifdef SPLIT_TRANSPORT_ASYNC
+    okay &= async ? transaction_batch_async_end() : TRANSACTIONS_BATCH_END();
+#else
+    (void)async;
+    okay &= TRANSACTIONS_BATCH_END();
+#endif // SPLIT_TRANSPORT_ASYNC
+#if defined(SPLIT_TRANSPORT_STATS) && defined(PROFILER_ENABLE)
+    split_transport_stats_record_scan((uint64_t)(profiler_read_counter() - start) * 1000000 / profiler_counter_frequency());
+#elif defined(SPLIT_TRANSPORT_STATS)
+    split_transport_stats_record_scan(0);
+#endif
+    return okay;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return transactions_master_run(master_matrix, slave_matrix, &slave_matrix_master, false);
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+bool transactions_master_async(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // The previous synchronisation is still moving over the wire, keep scanning with the last known slave state
+    if (transport_async_busy()) {
+        split_transport_stats_record_pending();
+        memcpy(slave_matrix, slave_matrix_async_last, sizeof(slave_matrix_async_last));
+        return true;
+    }
+    // Outcomes are taken in the order they were queued: the batch, then the slave matrix read
+    bool okay = transaction_batch_async_finish();
+    // A failed read can't be retried within the scan, the next one repairs it
+    okay &= transactions_master_run(master_matrix, slave_matrix, &slave_matrix_async_handlers_master, true);
+    slave_matrix_async_start();
+    return okay;
+}
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
+void transactions_master_init(void) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    batch_restarted = true;
+#endif // SPLIT_TRANSACTION_BATCH
+#ifdef SPLIT_TRANSPORT_ASYNC
+    batch_async_pending        = false;
+    slave_matrix_async_pending = false;
+    memset(slave_matrix_async_last, 0, sizeof(slave_matrix_async_last));
+#endif // SPLIT_TRANSPORT_ASYNC
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
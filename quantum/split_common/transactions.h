@@ -43,6 +43,14 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 
 // returns false if valid data not received from slave
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Same as transactions_master(), with the batched writes and the slave matrix
+// read moving over the wire on the transport thread. Returns straight away with
+// the last known slave matrix while they are still running.
+bool transactions_master_async(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+#endif // SPLIT_TRANSPORT_ASYNC
+// Starts the master side over, when the transport (re)starts
+void transactions_master_init(void);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
@@ -51,3 +59,40 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_TRANSPORT_STATS
+typedef struct split_transaction_latency_t {
+    uint32_t count;
+    uint32_t max_us;
+    uint32_t total_us;
+} split_transaction_latency_t;
+
+typedef struct split_transport_stats_t {
+    uint32_t scans;            // number of master/slave synchronisations
+    uint32_t transactions;     // transactions attempted, including retries
+    uint32_t failed;           // transactions that did not complete
+    uint32_t bytes;            // bytes moved in both directions, including the transaction ids
+    uint32_t matrix_deltas;    // slave matrix reads served as a delta, with SPLIT_MATRIX_DELTA
+    uint32_t matrix_full;      // full slave matrix reads, with SPLIT_MATRIX_DELTA
+    uint32_t latency_min_us;   // round trip of a whole synchronisation, with PROFILER_ENABLE
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+    uint32_t async_pending; // scans that found the previous synchronisation still running, with SPLIT_TRANSPORT_ASYNC
+    // Round trip of each transaction id, with PROFILER_ENABLE
+    split_transaction_latency_t transaction_latency[NUM_TOTAL_TRANSACTIONS];
+} split_transport_stats_t;
+
+const split_transport_stats_t *split_transport_get_stats(void);
+void                           split_transport_reset_stats(void);
+uint32_t                       split_transport_bytes_per_scan(void);
+uint32_t                       split_transport_average_latency_us(void);
+uint32_t                       split_transport_transaction_latency_us(int8_t id);
+
+void split_transport_stats_record_transaction(int8_t id, uint16_t bytes, uint32_t latency_us, bool okay);
+void split_transport_stats_record_matrix(bool delta);
+void split_transport_stats_record_pending(void);
+#else
+#    define split_transport_stats_record_transaction(id, bytes, latency_us, okay)
+#    define split_transport_stats_record_matrix(delta)
+#    define split_transport_stats_record_pending()
+#endif // SPLIT_TRANSPORT_STATS
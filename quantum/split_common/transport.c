@@ -22,6 +22,15 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "util.h"
+
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
+
+#if defined(SPLIT_TRANSPORT_ASYNC) && (defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG))
+#    error "SPLIT_TRANSPORT_ASYNC requires the usart or vendor serial driver"
+#endif
 
 #ifdef USE_I2C
 
@@ -43,6 +52,7 @@ split_shared_memory_t *const split_shmem = (split_shared_memory_t *)i2c_slave_re
 
 void transport_master_init(void) {
     i2c_init();
+    transactions_master_init();
 }
 void transport_slave_init(void) {
     i2c_slave_init(SLAVE_I2C_ADDRESS);
@@ -60,7 +70,7 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -96,12 +106,13 @@ split_shared_memory_t *const split_shmem = &shared_memory;
 
 void transport_master_init(void) {
     soft_serial_initiator_init();
+    transactions_master_init();
 }
 void transport_slave_init(void) {
     soft_serial_target_init();
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
@@ -122,8 +133,64 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
 #endif // USE_I2C
 
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#if defined(SPLIT_TRANSPORT_STATS) && defined(PROFILER_ENABLE)
+    uint32_t start = profiler_read_counter();
+#endif
+    bool okay = transport_execute(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#ifdef SPLIT_TRANSPORT_STATS
+    uint32_t latency_us = 0;
+#    ifdef PROFILER_ENABLE
+    latency_us = (uint64_t)(profiler_read_counter() - start) * 1000000 / profiler_counter_frequency();
+#    endif // PROFILER_ENABLE
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+#    ifdef USE_I2C
+    // Only the requested lengths go over the bus, plus the callback trigger
+    uint16_t bytes = MIN(trans->initiator2target_buffer_size, initiator2target_length) + MIN(trans->target2initiator_buffer_size, target2initiator_length) + (trans->slave_callback ? sizeof(int8_t) : 0);
+#    else
+    // The serial protocol always moves the whole registered buffers after the transaction id
+    uint16_t bytes = sizeof(int8_t) + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+#    endif // USE_I2C
+    split_transport_stats_record_transaction(id, bytes, latency_us, okay);
+#endif // SPLIT_TRANSPORT_STATS
+    return okay;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+bool transport_async_start(int8_t id) {
+    return soft_serial_async_transaction(id);
+}
+
+bool transport_async_busy(void) {
+    return soft_serial_async_busy();
+}
+
+bool transport_async_finish(int8_t id) {
+    uint32_t ticks = 0;
+    bool     okay  = soft_serial_async_result(&ticks);
+#    ifdef SPLIT_TRANSPORT_STATS
+    // Round trip from queueing on the main loop to completion on the transport thread
+    uint32_t latency_us = 0;
+#        ifdef PROFILER_ENABLE
+    latency_us = (uint64_t)ticks * 1000000 / profiler_counter_frequency();
+#        endif // PROFILER_ENABLE
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    split_transport_stats_record_transaction(id, sizeof(int8_t) + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size, latency_us, okay);
+#    else
+    (void)ticks;
+#    endif // SPLIT_TRANSPORT_STATS
+    return okay;
+}
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    return transactions_master_async(master_matrix, slave_matrix);
+#else
     return transactions_master(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
 void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
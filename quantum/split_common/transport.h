@@ -22,6 +22,7 @@
 #include "progmem.h"
 #include "action_layer.h"
 #include "matrix.h"
+#include "transaction_id_define.h"
 
 #ifndef RPC_M2S_BUFFER_SIZE
 #    define RPC_M2S_BUFFER_SIZE 32
@@ -40,6 +41,17 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Queues a transaction to move its buffers on the transport thread, after any
+// already queued. Nothing else may use the transport or the buffers of queued
+// transactions until transport_async_busy() returns false.
+// transport_async_finish() then returns their outcomes in the order they were
+// queued.
+bool transport_async_start(int8_t id);
+bool transport_async_busy(void);
+bool transport_async_finish(int8_t id);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -52,9 +64,27 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifdef SPLIT_MATRIX_DELTA
+#    ifndef SPLIT_MATRIX_DELTA_ROWS
+#        define SPLIT_MATRIX_DELTA_ROWS 2
+#    endif // SPLIT_MATRIX_DELTA_ROWS
+
+// Rows of the slave matrix that changed since the previous delta, the changed
+// rows are packed in row order. More bits set than SPLIT_MATRIX_DELTA_ROWS
+// means the rows did not fit and the full matrix has to be read instead.
+typedef struct _split_slave_matrix_delta_t {
+    uint8_t      checksum;
+    uint8_t      changed[((MATRIX_ROWS) / 2 + 7) / 8];
+    matrix_row_t rows[SPLIT_MATRIX_DELTA_ROWS];
+} split_slave_matrix_delta_t;
+#endif // SPLIT_MATRIX_DELTA
+
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
+#ifdef SPLIT_MATRIX_DELTA
+    split_slave_matrix_delta_t delta;
+#endif // SPLIT_MATRIX_DELTA
 } split_slave_matrix_sync_t;
 
 #ifdef SPLIT_TRANSPORT_MIRROR
@@ -147,6 +177,28 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE 32
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+
+// Master to slave writes of one scan, as a sequence of records made of the
+// transaction id followed by the full buffer registered for that transaction.
+// The checksum covers the sequence number and the records, the slave replies
+// with the sequence number of the batch once it has been applied, or with
+// SPLIT_BATCH_SEQUENCE_NACK if it was rejected. The first batch after the
+// master (re)starts carries SPLIT_BATCH_SEQUENCE_RESTART and is always applied.
+#    define SPLIT_BATCH_SEQUENCE_RESTART 0
+#    define SPLIT_BATCH_SEQUENCE_NACK UINT8_MAX
+
+typedef struct _split_batch_sync_t {
+    uint8_t length;
+    uint8_t checksum;
+    uint8_t sequence;
+    uint8_t records[SPLIT_TRANSACTION_BATCH_SIZE];
+} split_batch_sync_t;
+#endif // SPLIT_TRANSACTION_BATCH
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -222,6 +274,11 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    split_batch_sync_t batch;
+    uint8_t            batch_ack;
+#endif // SPLIT_TRANSACTION_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
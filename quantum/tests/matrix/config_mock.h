@@ -0,0 +1,29 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef SPLIT_KEYBOARD
+// Both halves have the same layout, one row of which is read back from the other half
+#    define MATRIX_ROWS 4
+#else
+#    define MATRIX_ROWS 2
+#endif
+#define MATRIX_COLS 2
+
+/* Here, "pins" from 0 to 7 are allowed. */
+#define DIRECT_PINS \
+    { {0, 1}, {2, NO_PIN} }
+
+#define MATRIX_IDLE_WAKEUP_DELAY 50
+#define MATRIX_IDLE_WAKEUP_SLEEP 10
+#define MATRIX_IDLE_WAKEUP_SPLIT_SLEEP 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
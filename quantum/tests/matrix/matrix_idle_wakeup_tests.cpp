@@ -0,0 +1,171 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "tests/matrix/mock.h"
+
+extern matrix_row_t matrix[MATRIX_ROWS];
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#ifdef SPLIT_KEYBOARD
+// The split master keeps polling the other half while idle
+#    define IDLE_SLEEP MATRIX_IDLE_WAKEUP_SPLIT_SLEEP
+#else
+#    define IDLE_SLEEP MATRIX_IDLE_WAKEUP_SLEEP
+#endif
+
+class MatrixIdleWakeup : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+        set_time(0);
+        matrix_init();
+        // Leaves idle mode over from a previous test, as matrix_init() doesn't reset it
+        if (matrix_is_idle()) {
+            press(0);
+            matrix_scan();
+            release(0);
+            matrix_scan();
+        }
+        mock_reset_wakeup();
+    }
+
+    static void mock_reset_wakeup(void) {
+        wakeup_sleep_time   = 0;
+        wakeup_last_timeout = 0;
+    }
+
+    static void press(pin_t pin) {
+        pins[pin] = false;
+    }
+
+    static void release(pin_t pin) {
+        pins[pin] = true;
+    }
+
+    // Scans once per millisecond for the given time, like an active keyboard_task() would
+    static void scan_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            matrix_scan();
+            advance_time(1);
+        }
+    }
+
+    static bool all_pins_armed(void) {
+        return pins_armed[0] && pins_armed[1] && pins_armed[2];
+    }
+
+    static bool any_pin_armed(void) {
+        for (bool armed : pins_armed) {
+            if (armed) return true;
+        }
+        return false;
+    }
+};
+
+TEST_F(MatrixIdleWakeup, GoesIdleAfterDelay) {
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY - 1);
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_FALSE(any_pin_armed());
+
+    scan_for(2);
+    EXPECT_TRUE(matrix_is_idle());
+    EXPECT_TRUE(all_pins_armed());
+    EXPECT_EQ(wakeup_sleep_time, 0u);
+}
+
+TEST_F(MatrixIdleWakeup, SleepsWhileIdle) {
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY + 1);
+    ASSERT_TRUE(matrix_is_idle());
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_FALSE(matrix_scan());
+    }
+    EXPECT_TRUE(matrix_is_idle());
+    EXPECT_EQ(wakeup_last_timeout, IDLE_SLEEP);
+    EXPECT_EQ(wakeup_sleep_time, 10u * IDLE_SLEEP);
+}
+
+TEST_F(MatrixIdleWakeup, KeyHeldDoesNotGoIdle) {
+    press(1);
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY * 4);
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_EQ(matrix[0], 0b10);
+
+    // The release restarts the delay
+    release(1);
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY - 1);
+    EXPECT_FALSE(matrix_is_idle());
+    scan_for(2);
+    EXPECT_TRUE(matrix_is_idle());
+}
+
+TEST_F(MatrixIdleWakeup, KeyPressWakesUp) {
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY + 1);
+    ASSERT_TRUE(matrix_is_idle());
+
+    // The key press is reported by the same scan that wakes the matrix up
+    press(2);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_FALSE(any_pin_armed());
+    EXPECT_EQ(matrix[0], 0u);
+    EXPECT_EQ(matrix[1], 0b01);
+
+    // Full scanning picks up further changes
+    press(0);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[0], 0b01);
+    release(0);
+    release(2);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[0], 0u);
+    EXPECT_EQ(matrix[1], 0u);
+    EXPECT_FALSE(matrix_is_idle());
+
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY + 1);
+    EXPECT_TRUE(matrix_is_idle());
+    EXPECT_TRUE(all_pins_armed());
+}
+
+#ifdef SPLIT_KEYBOARD
+TEST_F(MatrixIdleWakeup, OtherHalfKeyHeldDoesNotGoIdle) {
+    mock_other_half[1] = 0b01;
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY * 4);
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_EQ(matrix[3], 0b01);
+
+    mock_other_half[1] = 0;
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY - 1);
+    EXPECT_FALSE(matrix_is_idle());
+    scan_for(2);
+    EXPECT_TRUE(matrix_is_idle());
+}
+
+TEST_F(MatrixIdleWakeup, OtherHalfKeyPressWakesUpMaster) {
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY + 1);
+    ASSERT_TRUE(matrix_is_idle());
+    EXPECT_FALSE(matrix_scan());
+
+    mock_other_half[0] = 0b10;
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[2], 0b10);
+    EXPECT_FALSE(matrix_is_idle());
+    EXPECT_FALSE(any_pin_armed());
+}
+
+TEST_F(MatrixIdleWakeup, SlaveSleepsForFullTime) {
+    mock_is_master = false;
+    scan_for(MATRIX_IDLE_WAKEUP_DELAY + 1);
+    ASSERT_TRUE(matrix_is_idle());
+
+    EXPECT_FALSE(matrix_scan());
+    EXPECT_EQ(wakeup_last_timeout, MATRIX_IDLE_WAKEUP_SLEEP);
+}
+#endif
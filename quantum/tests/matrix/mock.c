@@ -0,0 +1,85 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix.h"
+#include "matrix_wakeup.h"
+#include "mock.h"
+
+void advance_time(uint32_t ms);
+
+/* matrix state(1:on, 0:off), normally provided by matrix_common.c */
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+bool     pins[MOCK_PIN_COUNT]       = {0};
+bool     pins_armed[MOCK_PIN_COUNT] = {0};
+uint32_t wakeup_sleep_time          = 0;
+uint16_t wakeup_last_timeout        = 0;
+
+void mock_set_pin_input_high(pin_t pin) {
+    pins[pin] = true;
+}
+
+bool mock_read_pin(pin_t pin) {
+    return pins[pin];
+}
+
+#ifdef SPLIT_KEYBOARD
+volatile bool isLeftHand = true;
+uint8_t       thisHand, thatHand;
+
+bool    mock_is_master     = true;
+uint8_t mock_other_half[2] = {0};
+
+bool is_keyboard_master(void) {
+    return mock_is_master;
+}
+
+bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return true;
+}
+
+// Receives the other half's matrix, as the transport would on the master
+bool matrix_post_scan(void) {
+    if (!mock_is_master) {
+        return false;
+    }
+    bool changed = false;
+    for (uint8_t row = 0; row < 2; row++) {
+        changed |= matrix[thatHand + row] != mock_other_half[row];
+        matrix[thatHand + row] = mock_other_half[row];
+    }
+    return changed;
+}
+#endif
+
+void mock_reset(void) {
+#ifdef SPLIT_KEYBOARD
+    mock_is_master = true;
+    memset(mock_other_half, 0, sizeof(mock_other_half));
+#endif
+    memset(pins, 0, sizeof(pins));
+    memset(pins_armed, 0, sizeof(pins_armed));
+    wakeup_sleep_time   = 0;
+    wakeup_last_timeout = 0;
+}
+
+void matrix_wakeup_arm_pin(pin_t pin) {
+    pins_armed[pin] = true;
+}
+
+void matrix_wakeup_disarm_pin(pin_t pin) {
+    pins_armed[pin] = false;
+}
+
+// Sleeps for the whole timeout, as no pin interrupt can fire while the test is blocked here
+void matrix_wakeup_wait(uint16_t timeout_ms) {
+    wakeup_last_timeout = timeout_ms;
+    wakeup_sleep_time += timeout_ms;
+    advance_time(timeout_ms);
+}
+
+void matrix_init_kb(void) {}
+
+void matrix_scan_kb(void) {}
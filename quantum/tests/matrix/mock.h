@@ -0,0 +1,37 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t pin_t;
+
+#define MOCK_PIN_COUNT 8
+
+// Pins idle high and are pulled low by a key press
+extern bool pins[MOCK_PIN_COUNT];
+extern bool pins_armed[MOCK_PIN_COUNT];
+
+// Total time slept in matrix_wakeup_wait(), and the timeout of its last call
+extern uint32_t wakeup_sleep_time;
+extern uint16_t wakeup_last_timeout;
+
+#ifdef SPLIT_KEYBOARD
+// Whether this half is the master, and the matrix of the other half as received by matrix_post_scan()
+extern bool    mock_is_master;
+extern uint8_t mock_other_half[2];
+#endif
+
+#define gpio_set_pin_input_high(pin) (mock_set_pin_input_high(pin))
+#define gpio_read_pin(pin) (mock_read_pin(pin))
+// Direct pins are only ever inputs
+#define gpio_set_pin_output(pin) ((void)(pin))
+#define gpio_write_pin_low(pin) ((void)(pin))
+#define gpio_write_pin_high(pin) ((void)(pin))
+
+void mock_set_pin_input_high(pin_t pin);
+
+bool mock_read_pin(pin_t pin);
+
+void mock_reset(void);
@@ -0,0 +1,24 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+matrix_idle_wakeup_DEFS := -DMATRIX_IDLE_WAKEUP_ENABLE -DIGNORE_ATOMIC_BLOCK
+matrix_idle_wakeup_CONFIG := $(QUANTUM_PATH)/tests/matrix/config_mock.h
+
+matrix_idle_wakeup_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/tests/matrix/mock.c \
+	$(QUANTUM_PATH)/tests/matrix/matrix_idle_wakeup_tests.cpp
+
+matrix_idle_wakeup_split_DEFS := -DMATRIX_IDLE_WAKEUP_ENABLE -DIGNORE_ATOMIC_BLOCK -DSPLIT_KEYBOARD
+matrix_idle_wakeup_split_CONFIG := $(QUANTUM_PATH)/tests/matrix/config_mock.h
+
+matrix_idle_wakeup_split_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/tests/matrix/mock.c \
+	$(QUANTUM_PATH)/tests/matrix/matrix_idle_wakeup_tests.cpp
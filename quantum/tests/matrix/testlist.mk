@@ -0,0 +1,3 @@
+TEST_LIST += \
+	matrix_idle_wakeup \
+	matrix_idle_wakeup_split
@@ -24,15 +24,22 @@
 
 #include "via.h"
 
+#include <string.h>
+
 #include "raw_hid.h"
 #include "dynamic_keymap.h"
 #include "eeconfig.h"
 #include "matrix.h"
 #include "timer.h"
 #include "wait.h"
+#include "util.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 #include "nvm_via.h"
 
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
+
 #if defined(AUDIO_ENABLE)
 #    include "audio.h"
 #endif
@@ -279,10 +286,178 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef VIA_BULK_TRANSFER
+static struct {
+    uint8_t  command; // id_bulk_read_begin or id_bulk_write_begin while a transfer is in progress, 0 otherwise
+    bool     rle;
+    bool     retry_sent;
+    uint8_t  window;
+    uint8_t  seq;      // Reads: first packet not acknowledged yet. Writes: next packet expected.
+    uint8_t  sent;     // Reads: number of packets in flight
+    uint16_t accepted; // Writes: number of packets accepted, to acknowledge once per window
+    uint16_t offset;   // Reads: buffer offset of packet seq. Writes: buffer offset of the next packet.
+    uint16_t end;
+    uint16_t sent_end[VIA_BULK_TRANSFER_WINDOW]; // Reads: buffer offset after each packet in flight, by seq
+} via_bulk;
+
+// Sends packets from the first unacknowledged one until the window is full, or the end of the buffer is reached.
+static void via_bulk_send_window(uint8_t *data, uint8_t length) {
+    uint16_t offset = via_bulk.offset;
+    via_bulk.sent   = 0;
+    for (uint8_t i = 0; i < via_bulk.window; i++) {
+        uint8_t seq = via_bulk.seq + i;
+        uint8_t size;
+        memset(&data[2], 0, length - 2);
+        if (via_bulk.rle) {
+            size = dynamic_keymap_get_buffer_rle(&offset, via_bulk.end, &data[4], length - 4);
+        } else {
+            size = MIN(length - 4, via_bulk.end - offset);
+            dynamic_keymap_get_buffer(offset, size, &data[4]);
+            offset += size;
+        }
+        via_bulk.sent_end[seq % VIA_BULK_TRANSFER_WINDOW] = offset;
+        via_bulk.sent++;
+
+        data[0] = id_dynamic_keymap_bulk_transfer;
+        data[1] = id_bulk_data;
+        data[2] = seq;
+        data[3] = size | (offset >= via_bulk.end ? id_bulk_last : 0);
+        raw_hid_send(data, length);
+        if (offset >= via_bulk.end) {
+            break;
+        }
+    }
+}
+
+// Handles id_dynamic_keymap_bulk_transfer, returns true if the buffer should be sent back as the reply.
+static bool via_bulk_transfer_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, bulk_command_id, bulk_command_data ]
+    uint8_t *bulk_command_id = &(data[1]);
+    uint8_t *bulk_data       = &(data[2]);
+
+    switch (*bulk_command_id) {
+        case id_bulk_read_begin:
+        case id_bulk_write_begin: {
+            uint8_t  flags  = bulk_data[0];
+            uint16_t offset = (bulk_data[1] << 8) | bulk_data[2];
+            uint16_t size   = (bulk_data[3] << 8) | bulk_data[4];
+            uint8_t  window = MIN(bulk_data[5], VIA_BULK_TRANSFER_WINDOW);
+
+            uint32_t buffer_size = (uint32_t)dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+            bool     rle         = flags & id_bulk_rle;
+            if (window == 0 || (uint32_t)offset + size > buffer_size || (rle && (offset % 2 || size % 2))) {
+                via_bulk.command = 0;
+                bulk_data[0]     = id_bulk_error;
+                bulk_data[1]     = 0;
+                return true;
+            }
+
+            via_bulk.command    = *bulk_command_id;
+            via_bulk.rle        = rle;
+            via_bulk.retry_sent = false;
+            via_bulk.window     = window;
+            via_bulk.seq        = 0;
+            via_bulk.accepted   = 0;
+            via_bulk.offset     = offset;
+            via_bulk.end        = offset + size;
+            bulk_data[0]        = id_bulk_ok;
+            bulk_data[1]        = window;
+            if (*bulk_command_id == id_bulk_read_begin) {
+                raw_hid_send(data, length);
+                via_bulk_send_window(data, length);
+                return false;
+            }
+            return true;
+        }
+        case id_bulk_ack: {
+            // [2] last packet received in order
+            if (via_bulk.command != id_bulk_read_begin) {
+                break;
+            }
+            uint8_t acked = bulk_data[0] - via_bulk.seq + 1;
+            if (acked > via_bulk.sent) {
+                // Not one of the packets in flight, resend them all
+                acked = 0;
+            }
+            if (acked > 0) {
+                via_bulk.offset = via_bulk.sent_end[bulk_data[0] % VIA_BULK_TRANSFER_WINDOW];
+                via_bulk.seq += acked;
+            }
+            if (acked > 0 && via_bulk.offset >= via_bulk.end) {
+                // The last packet has been received
+                via_bulk.command = 0;
+                return false;
+            }
+            via_bulk_send_window(data, length);
+            return false;
+        }
+        case id_bulk_data: {
+            // [2] seq, [3] length | id_bulk_last, [4..] payload
+            if (via_bulk.command != id_bulk_write_begin) {
+                break;
+            }
+            uint8_t seq    = bulk_data[0];
+            uint8_t size   = bulk_data[1] & ~id_bulk_last;
+            bool    last   = bulk_data[1] & id_bulk_last;
+            uint8_t status = id_bulk_ok;
+            if (seq != via_bulk.seq) {
+                // Ask for the packets after the last one accepted, once per lost packet
+                if (via_bulk.retry_sent) {
+                    return false;
+                }
+                via_bulk.retry_sent = true;
+                status              = id_bulk_retry;
+            } else {
+                bool valid = size <= length - 4;
+                if (valid && via_bulk.rle) {
+                    valid = dynamic_keymap_set_buffer_rle(&via_bulk.offset, via_bulk.end, &data[4], size);
+                } else if (valid) {
+                    valid = size <= via_bulk.end - via_bulk.offset;
+                    if (valid) {
+                        dynamic_keymap_set_buffer(via_bulk.offset, size, &data[4]);
+                        via_bulk.offset += size;
+                    }
+                }
+
+                if (!valid) {
+                    via_bulk.command = 0;
+                    status           = id_bulk_error;
+                } else {
+                    via_bulk.seq++;
+                    via_bulk.accepted++;
+                    via_bulk.retry_sent = false;
+                    if (last || via_bulk.offset >= via_bulk.end) {
+                        via_bulk.command = 0;
+                    } else if (via_bulk.accepted % via_bulk.window != 0) {
+                        return false;
+                    }
+                }
+            }
+
+            *bulk_command_id = id_bulk_ack;
+            memset(bulk_data, 0, length - 2);
+            bulk_data[0] = via_bulk.seq - 1;
+            bulk_data[1] = status;
+            return true;
+        }
+    }
+
+    // Unknown command, or no matching transfer in progress
+    data[0] = id_unhandled;
+    return true;
+}
+#endif // VIA_BULK_TRANSFER
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
+#ifdef PROFILER_ENABLE
+    if (profiler_raw_hid_receive(data, length)) {
+        return;
+    }
+#endif
+
     // If via_command_kb() returns true, the command was fully
     // handled, including calling raw_hid_send()
     if (via_command_kb(data, length)) {
@@ -439,6 +614,15 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef VIA_BULK_TRANSFER
+        case id_dynamic_keymap_bulk_transfer: {
+            // Reads are streamed from within, and writes are only acknowledged once per window
+            if (!via_bulk_transfer_command(data, length)) {
+                return;
+            }
+            break;
+        }
+#endif // VIA_BULK_TRANSFER
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
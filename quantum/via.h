@@ -73,9 +73,55 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_bulk_transfer         = 0x16,
     id_unhandled                            = 0xFF,
 };
 
+// Streaming transfers of the dynamic keymap buffer, enabled by defining VIA_BULK_TRANSFER.
+//
+// All packets are [ id_dynamic_keymap_bulk_transfer, via_bulk_command_id, ... ]
+//
+// Begin:   host   -> device [ cmd, id_bulk_read_begin/id_bulk_write_begin, flags, offset_hi, offset_lo, size_hi, size_lo, window ]
+//          device -> host   [ cmd, id_bulk_read_begin/id_bulk_write_begin, status, window ]
+// Data:    either direction [ cmd, id_bulk_data, seq, length | id_bulk_last, payload (up to 28 bytes) ]
+// Ack:     either direction [ cmd, id_bulk_ack, seq, status ]
+//
+// Offset and size are in bytes of the buffer described in dynamic_keymap.h. The window granted by the device
+// is the number of data packets sent without waiting for an ack. Sequence numbers start at 0 and wrap at 256.
+//
+// Reads:  the device sends a window of data packets after the begin reply. The host acks the last packet it
+//         received in order, and the device then sends the next window starting after it, resending any packet
+//         the host missed. Acking the last packet completes the transfer.
+// Writes: the host sends data packets. The device acks once per window and on the last packet. An out of
+//         order packet is answered once with id_bulk_retry and the sequence of the last packet accepted, and
+//         the host resends from the packet after it.
+//
+// With id_bulk_rle, offset and size must be even, and the payload is a series of tokens of 16-bit keycodes:
+//   0b0nnnnnnn, followed by n big-endian keycodes
+//   0b1nnnnnnn, followed by one big-endian keycode repeated n times
+// Tokens never span packets.
+#ifndef VIA_BULK_TRANSFER_WINDOW
+#    define VIA_BULK_TRANSFER_WINDOW 8
+#endif
+
+enum via_bulk_command_id {
+    id_bulk_read_begin  = 0x01,
+    id_bulk_write_begin = 0x02,
+    id_bulk_data        = 0x03,
+    id_bulk_ack         = 0x04,
+};
+
+enum via_bulk_status {
+    id_bulk_ok    = 0x00,
+    id_bulk_error = 0x01,
+    id_bulk_retry = 0x02,
+};
+
+enum via_bulk_flags {
+    id_bulk_rle  = 0x01,
+    id_bulk_last = 0x80,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
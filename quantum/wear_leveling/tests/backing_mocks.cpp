@@ -31,6 +31,10 @@ void MockBackingStore::reset_instance() {
     lock_success_callback   = [](std::uint64_t) { return true; };
 
     write_log.clear();
+
+    erase_pending              = false;
+    erase_busy_polls           = 0;
+    erase_busy_polls_remaining = 0;
 }
 
 bool MockBackingStore::init(void) {
@@ -56,6 +60,7 @@ bool MockBackingStore::unlock(void) {
 
 bool MockBackingStore::erase(void) {
     ++backing_erase_invoke_count;
+    EXPECT_FALSE(erase_pending) << "Erase was attempted while a sector erase was in progress";
 
     // Erase each slot
     for (std::size_t i = 0; i < backing_storage.size(); ++i) {
@@ -75,6 +80,42 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+bool MockBackingStore::erase_sector_start(uint32_t address) {
+    ++backing_erase_invoke_count;
+
+    EXPECT_TRUE(address % WEAR_LEVELING_SECTOR_SIZE == 0) << "Supplied address was not aligned with the sector size";
+    EXPECT_TRUE(address + WEAR_LEVELING_SECTOR_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+    EXPECT_FALSE(erase_pending) << "Erase was attempted while another sector erase was in progress";
+
+    // Drop out of erase early with failure if we need to
+    if (erase_success_callback && !erase_success_callback(backing_erase_invoke_count)) {
+        return false;
+    }
+
+    for (std::size_t i = address / BACKING_STORE_WRITE_SIZE; i < (address + WEAR_LEVELING_SECTOR_SIZE) / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[i].erase();
+    }
+    erase_pending              = true;
+    erase_busy_polls_remaining = erase_busy_polls;
+    return true;
+}
+
+bool MockBackingStore::erase_sector_poll(bool& done) {
+    EXPECT_TRUE(erase_pending) << "Erase was polled without having been started";
+    EXPECT_FALSE(is_locked()) << "Erase was polled after being locked";
+
+    done = erase_busy_polls_remaining == 0;
+    if (done) {
+        erase_pending = false;
+    } else {
+        --erase_busy_polls_remaining;
+    }
+    return true;
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -82,6 +123,7 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
     EXPECT_FALSE(is_locked()) << "Write was attempted without being unlocked first";
+    EXPECT_FALSE(erase_pending) << "Write was attempted while a sector erase was in progress";
 
     // Drop out of write early with failure if we need to
     if (write_success_callback && !write_success_callback(backing_write_invoke_count, address)) {
@@ -105,6 +147,7 @@ bool MockBackingStore::lock(void) {
     ++backing_lock_invoke_count;
 
     EXPECT_FALSE(is_locked()) << "Attempted to lock but was not unlocked";
+    EXPECT_FALSE(erase_pending) << "Attempted to lock while a sector erase was in progress";
     locked = true;
 
     if (lock_success_callback) {
@@ -141,6 +184,16 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+extern "C" bool backing_store_erase_sector_start(uint32_t address) {
+    return MockBackingStore::Instance().erase_sector_start(address);
+}
+
+extern "C" bool backing_store_erase_sector_poll(bool* done) {
+    return MockBackingStore::Instance().erase_sector_poll(*done);
+}
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -89,6 +89,11 @@ class MockBackingStore {
     std::uint64_t backing_total_write_count;
     // The write log for the backing store
     std::vector<MockBackingStoreLogEntry> write_log;
+    // Whether a sector erase has been started and not yet reported as complete
+    bool erase_pending;
+    // The number of polls reporting a sector erase as still in progress
+    std::uint32_t erase_busy_polls;
+    std::uint32_t erase_busy_polls_remaining;
 
     // The number of times each API was invoked
     std::uint64_t backing_init_invoke_count;
@@ -159,6 +164,10 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    bool erase_sector_start(std::uint32_t address);
+    bool erase_sector_poll(bool& done);
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
@@ -179,6 +188,13 @@ class MockBackingStore {
     void set_lock_callback(std::function<bool(std::uint64_t)> callback) {
         lock_success_callback = callback;
     }
+    // Control over how long sector erases take
+    void set_erase_busy_polls(std::uint32_t polls) {
+        erase_busy_polls = polls;
+    }
+    bool is_erase_pending() const {
+        return erase_pending;
+    }
 
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
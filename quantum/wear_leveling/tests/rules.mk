@@ -21,6 +21,34 @@ wear_leveling_general_SRC := \
 wear_leveling_general_INC := \
 	$(wear_leveling_common_INC)
 
+wear_leveling_deferred_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=256 \
+	-DWEAR_LEVELING_DEFERRED_COMMIT
+wear_leveling_deferred_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_deferred.cpp
+wear_leveling_deferred_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_async_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_ASYNC_CONSOLIDATION \
+	-DWEAR_LEVELING_SECTOR_SIZE=64 \
+	-DWEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE=16
+wear_leveling_async_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_async.cpp
+wear_leveling_async_INC := \
+	$(wear_leveling_common_INC)
+
 wear_leveling_2byte_optimized_writes_DEFS := \
 	$(wear_leveling_common_DEFS) \
 	-DBACKING_STORE_WRITE_SIZE=2 \
@@ -1,5 +1,7 @@
 TEST_LIST += \
 	wear_leveling_general \
+	wear_leveling_deferred \
+	wear_leveling_async \
 	wear_leveling_2byte_optimized_writes \
 	wear_leveling_2byte \
 	wear_leveling_4byte \
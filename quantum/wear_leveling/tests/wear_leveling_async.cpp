@@ -0,0 +1,208 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <memory>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+class WearLevelingAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        expected.fill(0);
+    }
+
+    static wear_leveling_stats_t stats() {
+        wear_leveling_stats_t s;
+        wear_leveling_get_stats(&s);
+        return s;
+    }
+
+    static std::uint64_t backing_operations() {
+        auto& inst = MockBackingStore::Instance();
+        return inst.write_invoke_count() + inst.erase_invoke_count();
+    }
+
+    static logical_data_t read_all() {
+        logical_data_t data;
+        wear_leveling_read(0, data.data(), data.size());
+        return data;
+    }
+
+    // Deterministic sequence of small writes spread over the logical area, as produced by eeconfig updates
+    wear_leveling_status_t scripted_write(std::uint32_t n) {
+        std::uint32_t address = (n * 37) % (WEAR_LEVELING_LOGICAL_SIZE - 1);
+        std::uint8_t  value[2]{(std::uint8_t)(n + 1), (std::uint8_t)(n * 3 + 2)};
+        std::size_t   length = n % 3 == 0 ? 2 : 1;
+        memcpy(&expected[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    logical_data_t expected;
+};
+
+/**
+ * This test verifies that consolidation happens in steps across task invocations, with reads staying consistent throughout.
+ */
+TEST_F(WearLevelingAsync, ConsolidationIsSpreadAcrossTasks) {
+    std::uint64_t max_operations = 0;
+    for (std::uint32_t n = 0; n < 400; ++n) {
+        std::uint64_t before = backing_operations();
+        EXPECT_NE(scripted_write(n), WEAR_LEVELING_FAILED) << "Write failed";
+        max_operations = std::max(max_operations, backing_operations() - before);
+
+        before = backing_operations();
+        wear_leveling_task();
+        max_operations = std::max(max_operations, backing_operations() - before);
+
+        EXPECT_EQ(read_all(), expected) << "Invalid readback during consolidation";
+    }
+
+    EXPECT_GE(stats().consolidations, 3) << "Banks should have been switched several times";
+    EXPECT_EQ(MockBackingStore::Instance().erasure_count(), 0) << "The entire backing store should never have been erased";
+    EXPECT_LT(max_operations, WEAR_LEVELING_LOGICAL_SIZE / BACKING_STORE_WRITE_SIZE) << "A single call should never rewrite all of the consolidated data";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that sector erases are polled across task invocations rather than waited for, and that writes made
+ * while an erase is in progress wait for it to complete before touching the backing store.
+ */
+TEST_F(WearLevelingAsync, SectorEraseIsPolledAcrossTasks) {
+    auto& inst = MockBackingStore::Instance();
+    inst.set_erase_busy_polls(3);
+
+    bool          erase_seen_pending = false;
+    std::uint32_t n;
+    for (n = 0; n < 400 && !erase_seen_pending; ++n) {
+        EXPECT_NE(scripted_write(n), WEAR_LEVELING_FAILED) << "Write failed";
+        wear_leveling_task();
+        erase_seen_pending = inst.is_erase_pending();
+    }
+    EXPECT_TRUE(erase_seen_pending) << "A sector erase should have still been in progress after a task invocation";
+
+    // The erase stays in progress for the configured number of polls, with the backing store left unlocked throughout
+    std::uint64_t erases = inst.erase_invoke_count();
+    for (int i = 0; i < 2; ++i) {
+        wear_leveling_task();
+        EXPECT_TRUE(inst.is_erase_pending()) << "Sector erase completed too early";
+        EXPECT_EQ(inst.erase_invoke_count(), erases) << "Another sector erase was started while one was in progress";
+    }
+
+    // Writes wait for the erase to complete
+    EXPECT_NE(scripted_write(n++), WEAR_LEVELING_FAILED) << "Write failed";
+    EXPECT_FALSE(inst.is_erase_pending()) << "Write should have waited for the sector erase";
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should have been locked after the write";
+
+    for (; n < 400; ++n) {
+        EXPECT_NE(scripted_write(n), WEAR_LEVELING_FAILED) << "Write failed";
+        wear_leveling_task();
+        EXPECT_EQ(read_all(), expected) << "Invalid readback during consolidation";
+    }
+    EXPECT_GE(stats().consolidations, 3) << "Banks should have been switched several times";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that a full write log completes the consolidation in the foreground when the task isn't invoked.
+ */
+TEST_F(WearLevelingAsync, FullLogConsolidatesInForeground) {
+    bool consolidated = false;
+    for (std::uint32_t n = 0; n < 200; ++n) {
+        wear_leveling_status_t status = scripted_write(n);
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write failed";
+        consolidated |= status == WEAR_LEVELING_CONSOLIDATED;
+    }
+    EXPECT_TRUE(consolidated) << "A write should have reported consolidation";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Invalid readback after re-init";
+}
+
+/**
+ * This test verifies that an erase abandons any consolidation in progress.
+ */
+TEST_F(WearLevelingAsync, EraseAbandonsConsolidation) {
+    for (std::uint32_t n = 0; n < 40; ++n) {
+        scripted_write(n);
+    }
+    wear_leveling_task();
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase returned incorrect status";
+    for (int i = 0; i < 100; ++i) {
+        wear_leveling_task();
+    }
+
+    uint8_t test_value = 0x42;
+    wear_leveling_write(0x10, &test_value, sizeof(test_value));
+    expected.fill(0);
+    expected[0x10] = test_value;
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_all(), expected) << "Invalid readback after re-init";
+}
+
+/**
+ * This test simulates a power loss before every single backing store operation, including each step of the background
+ * consolidation, and verifies that the data read back after restarting is either the state before or after the last
+ * write. No earlier write may be lost.
+ */
+TEST_F(WearLevelingAsync, PowerLossAtEveryStep) {
+    auto& inst = MockBackingStore::Instance();
+
+    const std::uint32_t writes = 300;
+    for (std::uint64_t power_loss_at = 0;; ++power_loss_at) {
+        SetUp();
+
+        // After the power loss, nothing more reaches the backing store
+        auto operations = std::make_shared<std::uint64_t>(0);
+        inst.set_write_callback([=](std::uint64_t, std::uint32_t) { return ++*operations <= power_loss_at; });
+        inst.set_erase_callback([=](std::uint64_t) { return ++*operations <= power_loss_at; });
+
+        logical_data_t before_write = expected;
+        std::uint32_t  n;
+        for (n = 0; n < writes && *operations <= power_loss_at; ++n) {
+            before_write = expected;
+            scripted_write(n);
+            if (*operations <= power_loss_at) {
+                before_write = expected;
+                wear_leveling_task();
+            }
+        }
+        if (*operations <= power_loss_at) {
+            // Went through all of the writes without losing power
+            EXPECT_GE(stats().consolidations, 3) << "Banks should have been switched several times";
+            break;
+        }
+
+        // Restart
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_callback([](std::uint64_t) { return true; });
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status, power loss at " << power_loss_at;
+
+        // A write spanning several log entries may be partially stored, so each byte is checked individually
+        logical_data_t readback = read_all();
+        for (std::size_t i = 0; i < readback.size(); ++i) {
+            EXPECT_TRUE(readback[i] == before_write[i] || readback[i] == expected[i]) << "Invalid readback at " << i << ", power loss at " << power_loss_at << " during write " << (n - 1);
+        }
+        if (HasFailure()) {
+            break;
+        }
+
+        // The restarted store keeps working
+        uint8_t test_value = 0xA5;
+        EXPECT_NE(wear_leveling_write(0x20, &test_value, sizeof(test_value)), WEAR_LEVELING_FAILED) << "Write after restart failed";
+        readback[0x20] = test_value;
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(read_all(), readback) << "Invalid readback after restart, power loss at " << power_loss_at;
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
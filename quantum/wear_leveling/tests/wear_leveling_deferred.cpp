@@ -0,0 +1,191 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class WearLevelingDeferred : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        timer_clear();
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    static wear_leveling_stats_t stats() {
+        wear_leveling_stats_t s;
+        wear_leveling_get_stats(&s);
+        return s;
+    }
+
+    static std::size_t log_size() {
+        auto& inst = MockBackingStore::Instance();
+        return std::distance(inst.log_begin(), inst.log_end());
+    }
+
+    // Re-reads the backing store, discarding anything that was not written to it
+    static void reinit() {
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    }
+};
+
+/**
+ * This test verifies that writes are served from the cache, and only reach the backing store once writes have settled.
+ */
+TEST_F(WearLevelingDeferred, WritesAreDeferredUntilSettled) {
+    uint8_t test_value = 0x15;
+    EXPECT_EQ(wear_leveling_write(0x50, &test_value, sizeof(test_value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(log_size(), 0) << "Write should have been deferred";
+
+    uint8_t readback = 0;
+    wear_leveling_read(0x50, &readback, sizeof(readback));
+    EXPECT_EQ(readback, test_value) << "Deferred write should be visible in the cache";
+
+    advance_time(WEAR_LEVELING_COMMIT_DELAY - 1);
+    wear_leveling_task();
+    EXPECT_EQ(log_size(), 0) << "Write should not have been committed before the delay";
+
+    advance_time(1);
+    wear_leveling_task();
+    EXPECT_EQ(stats().log_entries, 1) << "Write should have been committed after the delay";
+
+    reinit();
+    readback = 0;
+    wear_leveling_read(0x50, &readback, sizeof(readback));
+    EXPECT_EQ(readback, test_value) << "Committed write should survive re-initialisation";
+}
+
+/**
+ * This test verifies that each write postpones the commit of all pending writes.
+ */
+TEST_F(WearLevelingDeferred, WritesPostponeCommit) {
+    uint8_t test_value = 0x15;
+    wear_leveling_write(0x50, &test_value, sizeof(test_value));
+    advance_time(WEAR_LEVELING_COMMIT_DELAY - 1);
+    wear_leveling_task();
+    wear_leveling_write(0x60, &test_value, sizeof(test_value));
+    advance_time(WEAR_LEVELING_COMMIT_DELAY - 1);
+    wear_leveling_task();
+    EXPECT_EQ(log_size(), 0) << "Writes should not have been committed while still being written";
+
+    advance_time(1);
+    wear_leveling_task();
+    EXPECT_EQ(stats().log_entries, 2) << "Both writes should have been committed";
+}
+
+/**
+ * This test verifies that adjacent single byte writes are merged into a single multi-byte log entry.
+ */
+TEST_F(WearLevelingDeferred, AdjacentWritesAreMerged) {
+    for (uint8_t i = 0; i < LOG_ENTRY_MULTIBYTE_MAX_BYTES; ++i) {
+        uint8_t test_value = 0x20 + i;
+        wear_leveling_write(0x50 + i, &test_value, sizeof(test_value));
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(stats().log_entries, 1) << "Adjacent writes should have been merged";
+
+    reinit();
+    for (uint8_t i = 0; i < LOG_ENTRY_MULTIBYTE_MAX_BYTES; ++i) {
+        uint8_t readback = 0;
+        wear_leveling_read(0x50 + i, &readback, sizeof(readback));
+        EXPECT_EQ(readback, 0x20 + i) << "Invalid readback";
+    }
+}
+
+/**
+ * This test verifies that repeated writes to the same location only store the last value.
+ */
+TEST_F(WearLevelingDeferred, RepeatedWritesAreMerged) {
+    for (uint8_t i = 1; i <= 10; ++i) {
+        uint16_t test_value = 0x1100 * i;
+        wear_leveling_write(0x50, &test_value, sizeof(test_value));
+    }
+    wear_leveling_flush();
+    EXPECT_EQ(stats().log_entries, 1) << "Repeated writes should have been merged";
+
+    reinit();
+    uint16_t readback = 0;
+    wear_leveling_read(0x50, &readback, sizeof(readback));
+    EXPECT_EQ(readback, 0xAA00) << "Last written value should have been stored";
+}
+
+/**
+ * This test verifies that running out of dirty ranges merges the nearest ranges without losing any data.
+ */
+TEST_F(WearLevelingDeferred, DirtyRangeOverflowKeepsAllWrites) {
+    const uint32_t writes = 2 * WEAR_LEVELING_DIRTY_RANGES;
+    for (uint32_t i = 0; i < writes; ++i) {
+        // Spread out the writes in a non-sequential order, leaving a gap between each of them
+        uint32_t address    = 0x40 + ((i * 7) % writes) * 3;
+        uint8_t  test_value = 0x80 + i;
+        wear_leveling_write(address, &test_value, sizeof(test_value));
+    }
+    wear_leveling_flush();
+
+    reinit();
+    for (uint32_t i = 0; i < writes; ++i) {
+        uint32_t address  = 0x40 + ((i * 7) % writes) * 3;
+        uint8_t  readback = 0;
+        wear_leveling_read(address, &readback, sizeof(readback));
+        EXPECT_EQ(readback, 0x80 + i) << "Invalid readback at " << address;
+    }
+}
+
+/**
+ * This test verifies that a flush which fills the write log consolidates, and that every pending write is stored.
+ */
+TEST_F(WearLevelingDeferred, FlushConsolidatesWhenLogIsFull) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    for (uint8_t round = 0; round < 4; ++round) {
+        std::iota(testvalue.begin(), testvalue.end(), 0x20 + round);
+        for (uint32_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            wear_leveling_write(i, &testvalue[i], 1);
+        }
+        EXPECT_NE(wear_leveling_flush(), WEAR_LEVELING_FAILED) << "Flush failed";
+    }
+    EXPECT_GE(stats().consolidations, 1) << "Write log should have been consolidated";
+    EXPECT_EQ(stats().erases, stats().consolidations) << "Each consolidation should erase the backing store once";
+
+    reinit();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    wear_leveling_read(0, readback.data(), readback.size());
+    EXPECT_EQ(readback, testvalue) << "Invalid readback";
+}
+
+/**
+ * This test verifies that an erase discards pending writes.
+ */
+TEST_F(WearLevelingDeferred, EraseDiscardsPendingWrites) {
+    uint8_t test_value = 0x15;
+    wear_leveling_write(0x50, &test_value, sizeof(test_value));
+    wear_leveling_erase();
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_EQ(stats().log_entries, 0) << "Pending write should have been discarded";
+    EXPECT_EQ(stats().erases, 1) << "Erase should have been counted";
+}
+
+/**
+ * This test verifies that deferring writes reduces the write log usage compared to committing every write.
+ */
+TEST_F(WearLevelingDeferred, DeferredWritesUseFewerBackingWrites) {
+    // Emulates a keymap being uploaded one keycode at a time, above the range of the single byte optimisation
+    const uint32_t keycodes = (WEAR_LEVELING_LOGICAL_SIZE - 64) / 2;
+    for (uint32_t i = 0; i < keycodes; ++i) {
+        uint16_t keycode = 0x0004 + i;
+        wear_leveling_write(64 + 2 * i, &keycode, sizeof(keycode));
+    }
+    wear_leveling_flush();
+    auto deferred = stats();
+
+    // Committing each of the keycodes separately needs a multi-byte entry of 3 backing writes each
+    EXPECT_LT(deferred.log_entries, keycodes / 2) << "Deferred writes should use fewer log entries";
+    EXPECT_LT(deferred.backing_writes, 3 * keycodes) << "Deferred writes should use fewer backing writes";
+    EXPECT_EQ(deferred.consolidations, 0) << "Deferred writes should not have needed consolidation";
+}
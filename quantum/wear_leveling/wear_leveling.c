@@ -6,6 +6,10 @@
 #include "wear_leveling_drivers.h"
 #include "wear_leveling_internal.h"
 
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+#    include "timer.h"
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+
 /*
     This wear leveling algorithm is adapted from algorithms from previous
     implementations in QMK, namely:
@@ -62,6 +66,32 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_DEFERRED_COMMIT: If defined, writes only update the
+            cache and are appended to the write log once no further write has
+            occurred for WEAR_LEVELING_COMMIT_DELAY milliseconds, or when
+            wear_leveling_flush() is invoked.
+
+        - WEAR_LEVELING_DIRTY_RANGES: The number of modified address ranges
+            tracked while writes are deferred. Once exhausted, the nearest
+            ranges are merged, rewriting the unchanged bytes between them.
+
+        - WEAR_LEVELING_ASYNC_CONSOLIDATION: If defined, the backing store is
+            split into two banks, each with its own consolidated data, header
+            and write log. Consolidation into the other bank is performed one
+            sector erase or WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE bytes at a
+            time from wear_leveling_task(). Sector erases are started and then
+            polled on subsequent calls, so requires the backing store to
+            provide backing_store_erase_sector_start() and
+            backing_store_erase_sector_poll(). Enabling this option halves the
+            logical size the drivers default to, and changes the on-flash
+            format -- existing data is not migrated, and is lost.
+
+        - WEAR_LEVELING_SECTOR_SIZE: The erase granularity used by
+            backing_store_erase_sector_start().
+
+        - WEAR_LEVELING_CONSOLIDATION_RESERVE: The number of bytes of write log
+            left when background consolidation starts.
+
     General algorithm:
 
         During initialization:
@@ -77,6 +107,25 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With deferred commits:
+            * The cache is updated with the new data, and the modified range is
+                merged with any overlapping or adjacent modified ranges.
+            * Once writes have settled, each modified range is appended to the
+                log, using as few multi-byte entries as the encoding allows.
+
+        With background consolidation:
+            * Once less than WEAR_LEVELING_CONSOLIDATION_RESERVE bytes of write
+                log are left, the other bank is erased and the cache is copied
+                into it, one step per task invocation. Writes keep going to the
+                current bank's write log in the meantime.
+            * Ranges written after they were copied are appended to the new
+                bank's write log, and the new bank's sequence number and hash
+                are written last. Until the hash is written the old bank stays
+                the valid one, so power loss at any step loses nothing.
+            * On startup, the valid bank with the highest sequence is used.
+            * If the write log fills up before the task completes the
+                consolidation, it is finished in the foreground.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -165,6 +214,109 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     bool                                                           unlocked;
 } wear_leveling;
 
+/**
+ * Counters describing the backing store activity since initialisation.
+ */
+static wear_leveling_stats_t wear_leveling_stats;
+
+#if defined(WEAR_LEVELING_DEFERRED_COMMIT) || defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+/**
+ * Logical address range [start, end).
+ */
+typedef struct wear_leveling_range_t {
+    uint32_t start;
+    uint32_t end;
+} wear_leveling_range_t;
+
+/**
+ * Set of non-overlapping logical address ranges.
+ */
+typedef struct wear_leveling_range_set_t {
+    wear_leveling_range_t ranges[(WEAR_LEVELING_DIRTY_RANGES)];
+    uint8_t               count;
+} wear_leveling_range_set_t;
+
+/**
+ * Adds a range to the set, merging it with the ranges it overlaps or touches.
+ */
+static void wear_leveling_range_set_add(wear_leveling_range_set_t *set, uint32_t start, uint32_t end) {
+    for (uint8_t i = 0; i < set->count;) {
+        wear_leveling_range_t *r = &set->ranges[i];
+        if (start <= r->end && r->start <= end) {
+            start = r->start < start ? r->start : start;
+            end   = r->end > end ? r->end : end;
+            *r    = set->ranges[--set->count];
+            continue;
+        }
+        ++i;
+    }
+
+    if (set->count == (WEAR_LEVELING_DIRTY_RANGES)) {
+        // Out of ranges, so widen the new range to cover the nearest one -- the bytes in between are rewritten unchanged
+        uint8_t  nearest = 0;
+        uint32_t gap     = UINT32_MAX;
+        for (uint8_t i = 0; i < set->count; ++i) {
+            const wear_leveling_range_t *r = &set->ranges[i];
+            const uint32_t               g = r->end < start ? start - r->end : r->start - end;
+            if (g < gap) {
+                gap     = g;
+                nearest = i;
+            }
+        }
+        wear_leveling_range_t r = set->ranges[nearest];
+        set->ranges[nearest]    = set->ranges[--set->count];
+        wear_leveling_range_set_add(set, r.start < start ? r.start : start, r.end > end ? r.end : end);
+        return;
+    }
+
+    set->ranges[set->count++] = (wear_leveling_range_t){.start = start, .end = end};
+}
+#endif // defined(WEAR_LEVELING_DEFERRED_COMMIT) || defined(WEAR_LEVELING_ASYNC_CONSOLIDATION)
+
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+/**
+ * Modified ranges not yet appended to the write log.
+ */
+static struct {
+    wear_leveling_range_set_t pending;
+    uint32_t                  last_write;
+} wear_leveling_dirty;
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Background consolidation progress.
+ */
+typedef enum wear_leveling_consolidation_state_t {
+    CONSOLIDATION_IDLE,      // No consolidation in progress
+    CONSOLIDATION_ERASING,   // Erasing the other bank, one sector at a time
+    CONSOLIDATION_COPYING,   // Copying the cache to the other bank, one chunk per step
+    CONSOLIDATION_COMMITTING // Writing the header which makes the other bank current
+} wear_leveling_consolidation_state_t;
+
+/**
+ * Bank selection and background consolidation state.
+ */
+static struct {
+    uint32_t                            bank_base; // Backing address of the current bank
+    uint64_t                            sequence;  // Sequence number of the current bank
+    wear_leveling_consolidation_state_t state;
+    uint32_t                            offset;   // Progress through the other bank
+    bool                                erasing;  // A sector erase has been started and not yet completed
+    bool                                relock;   // The backing store was left unlocked for the sector erase
+    uint64_t                            hash;     // FNV1a_64 of the data copied so far
+    wear_leveling_range_set_t           modified; // Copied data changed since, appended to the new write log on commit
+} wear_leveling_async;
+
+#    define WEAR_LEVELING_BANK_BASE (wear_leveling_async.bank_base)
+
+static void                   wear_leveling_consolidation_start(void);
+static void                   wear_leveling_consolidation_wait(void);
+static wear_leveling_status_t wear_leveling_consolidate_force(void);
+#else
+#    define WEAR_LEVELING_BANK_BASE 0
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -203,9 +355,20 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+    wear_leveling_dirty.pending.count = 0;
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling_async.bank_base = 0;
+    wear_leveling_async.sequence  = 0;
+    wear_leveling_async.state     = CONSOLIDATION_IDLE;
+    wear_leveling_async.erasing   = false;
+    wear_leveling_async.relock    = false;
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling.write_address = WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOG_START);
 }
 
+#ifndef WEAR_LEVELING_ASYNC_CONSOLIDATION
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -259,6 +422,7 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
+    wear_leveling_stats.backing_writes += sizeof(wear_leveling.cache) / sizeof(backing_store_int_t) + 8 / (BACKING_STORE_WRITE_SIZE);
     if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
@@ -304,6 +468,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     wl_dprintf("Erasing backing store\n");
 
     // Erase the backing store. Expectation is that any un-written values that are read back after this call come back as zero.
+    ++wear_leveling_stats.erases;
     bool ok = backing_store_erase();
     if (!ok) {
         wl_dprintf("Failed to erase backing store\n");
@@ -315,13 +480,16 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
     }
+    ++wear_leveling_stats.consolidations;
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START);
 
     return status;
 }
 
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 /**
  * Potential write of the current cache to the backing store.
  * Skipped if the current write log position is not at the end of the backing store.
@@ -330,10 +498,17 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE)) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    // Leave room in the write log for the writes that happen while consolidating in the background
+    if (wear_leveling.write_address >= WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_CONSOLIDATION_RESERVE)) {
+        wear_leveling_consolidation_start();
+    }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
@@ -343,6 +518,7 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
+    ++wear_leveling_stats.backing_writes;
     bool ok = backing_store_write(wear_leveling.write_address, value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
@@ -360,6 +536,7 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
 static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address, const void *value, size_t length) {
     const uint8_t *   p   = value;
     write_log_entry_t log = LOG_ENTRY_MAKE_MULTIBYTE(address, length);
+    ++wear_leveling_stats.log_entries;
     for (size_t i = 0; i < length; ++i) {
         log.raw8[3 + i] = p[i];
     }
@@ -425,6 +602,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
             const uint16_t v = ((uint16_t)p[1]) << 8 | p[0]; // don't just dereference a uint16_t here -- if unaligned it generates faults on some MCUs
             if (v == 0 || v == 1) {
                 const write_log_entry_t log = LOG_ENTRY_MAKE_WORD_01(address, v);
+                ++wear_leveling_stats.log_entries;
                 status                      = wear_leveling_append_raw(log.raw16[0]);
                 if (status != WEAR_LEVELING_SUCCESS) {
                     // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
@@ -442,6 +620,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
         // Small-write optimizations - address<64:
         if (address < 64) {
             const write_log_entry_t log = LOG_ENTRY_MAKE_OPTIMIZED_64(address, *p);
+            ++wear_leveling_stats.log_entries;
             status                      = wear_leveling_append_raw(log.raw16[0]);
             if (status != WEAR_LEVELING_SUCCESS) {
                 // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
@@ -470,6 +649,285 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+/**
+ * Reads a 64-bit header value from the backing store.
+ */
+static bool wear_leveling_read_header(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+/**
+ * Writes a 64-bit header value to the backing store.
+ */
+static bool wear_leveling_write_header(uint32_t address, write_log_entry_t *entry) {
+    wear_leveling_stats.backing_writes += 8 / (BACKING_STORE_WRITE_SIZE);
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+/**
+ * Verifies the header of a bank against its consolidated data, without touching the cache.
+ *
+ * @return true if the bank holds complete consolidated data
+ */
+static bool wear_leveling_bank_is_valid(uint32_t bank_base, uint64_t *sequence) {
+    uint64_t hash = FNV1A_64_INIT;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(bank_base + offset, &value)) {
+            return false;
+        }
+        hash = fnv_64a_buf(&value, sizeof(value), hash);
+    }
+
+    write_log_entry_t expected, seq;
+    if (!wear_leveling_read_header(bank_base + (WEAR_LEVELING_LOGICAL_SIZE), &expected) || !wear_leveling_read_header(bank_base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &seq)) {
+        return false;
+    }
+    hash      = fnv_64a_buf(&seq.raw64, sizeof(seq.raw64), hash);
+    *sequence = seq.raw64;
+    return expected.raw64 == hash;
+}
+
+/**
+ * Selects the current bank and reads its consolidated data from the backing store into the cache.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    // The valid bank with the highest sequence number is current -- the other bank is either stale, or an interrupted consolidation.
+    uint64_t sequence[2] = {0};
+    bool     valid[2]    = {wear_leveling_bank_is_valid(0, &sequence[0]), wear_leveling_bank_is_valid((WEAR_LEVELING_BANK_SIZE), &sequence[1])};
+    uint8_t  bank        = (valid[1] && (!valid[0] || sequence[1] > sequence[0])) ? 1 : 0;
+    if (!valid[bank]) {
+        // Nothing consolidated yet, which caters for the completely clean MCU case.
+        wl_dprintf("No valid bank, clearing cache\n");
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Bank %d is current\n", (int)bank);
+    wear_leveling_async.bank_base = bank * (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling_async.sequence  = sequence[bank];
+    wear_leveling.write_address   = wear_leveling_async.bank_base + (WEAR_LEVELING_LOG_START);
+    if (!backing_store_read_bulk(wear_leveling_async.bank_base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        wl_dprintf("Failed to read from backing store\n");
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Begins consolidating the cache into the other bank, unless already in progress.
+ */
+static void wear_leveling_consolidation_start(void) {
+    if (wear_leveling_async.state == CONSOLIDATION_IDLE) {
+        wl_dprintf("Starting background consolidation\n");
+        wear_leveling_async.state  = CONSOLIDATION_ERASING;
+        wear_leveling_async.offset = 0;
+    }
+}
+
+/**
+ * Records a logical write which happened during consolidation, if it changed data that was already copied.
+ */
+static void wear_leveling_consolidation_track(uint32_t address, size_t length) {
+    if (wear_leveling_async.state != CONSOLIDATION_COPYING && wear_leveling_async.state != CONSOLIDATION_COMMITTING) {
+        return;
+    }
+    uint32_t end = address + (uint32_t)length;
+    if (end > wear_leveling_async.offset) {
+        end = wear_leveling_async.offset;
+    }
+    if (address < end) {
+        wear_leveling_range_set_add(&wear_leveling_async.modified, address, end);
+    }
+}
+
+/**
+ * Makes the other bank current.
+ *
+ * Data changed after being copied is appended to the new write log before the header is written, so that the new bank
+ * is complete as soon as its header is valid. Until then, the previous bank remains current.
+ */
+static wear_leveling_status_t wear_leveling_consolidation_commit(void) {
+    const uint32_t target = (WEAR_LEVELING_BANK_SIZE) - wear_leveling_async.bank_base;
+
+    // Worst case is a full multi-byte entry for every LOG_ENTRY_MULTIBYTE_MAX_BYTES bytes
+    uint32_t log_bytes = 0;
+    for (uint8_t i = 0; i < wear_leveling_async.modified.count; ++i) {
+        const wear_leveling_range_t *r = &wear_leveling_async.modified.ranges[i];
+        log_bytes += ((r->end - r->start + LOG_ENTRY_MULTIBYTE_MAX_BYTES - 1) / LOG_ENTRY_MULTIBYTE_MAX_BYTES) * 8;
+    }
+    if (log_bytes > ((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_START)) / 2) {
+        wl_dprintf("Too much data changed during consolidation, restarting\n");
+        wear_leveling_async.state  = CONSOLIDATION_ERASING;
+        wear_leveling_async.offset = 0;
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    const uint32_t previous_bank_base     = wear_leveling_async.bank_base;
+    const uint32_t previous_write_address = wear_leveling.write_address;
+    wear_leveling_async.bank_base         = target;
+    wear_leveling.write_address           = target + (WEAR_LEVELING_LOG_START);
+
+    bool ok = true;
+    for (uint8_t i = 0; ok && i < wear_leveling_async.modified.count; ++i) {
+        const wear_leveling_range_t *r = &wear_leveling_async.modified.ranges[i];
+        ok                             = wear_leveling_write_raw(r->start, &wear_leveling.cache[r->start], r->end - r->start) == WEAR_LEVELING_SUCCESS;
+    }
+
+    // The sequence number is covered by the hash, which is written last
+    write_log_entry_t entry;
+    entry.raw64 = wear_leveling_async.sequence + 1;
+    ok          = ok && wear_leveling_write_header(target + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry);
+    entry.raw64 = fnv_64a_buf(&entry.raw64, sizeof(entry.raw64), wear_leveling_async.hash);
+    ok          = ok && wear_leveling_write_header(target + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
+
+    if (!ok) {
+        wl_dprintf("Failed to commit consolidated data\n");
+        wear_leveling_async.bank_base = previous_bank_base;
+        wear_leveling.write_address   = previous_write_address;
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Consolidation complete\n");
+    ++wear_leveling_async.sequence;
+    wear_leveling_async.state          = CONSOLIDATION_IDLE;
+    wear_leveling_async.modified.count = 0;
+    ++wear_leveling_stats.consolidations;
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Performs a single step of the background consolidation, bounding the time spent to starting or polling one sector erase,
+ * or one chunk write.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the other bank has become current
+ */
+static wear_leveling_status_t wear_leveling_consolidation_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    const uint32_t         target = (WEAR_LEVELING_BANK_SIZE) - wear_leveling_async.bank_base;
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    switch (wear_leveling_async.state) {
+        case CONSOLIDATION_IDLE:
+            break;
+
+        case CONSOLIDATION_ERASING: {
+            if (!wear_leveling_async.erasing) {
+                ++wear_leveling_stats.erases;
+                if (!backing_store_erase_sector_start(target + wear_leveling_async.offset)) {
+                    wl_dprintf("Failed to erase backing store sector\n");
+                    status = WEAR_LEVELING_FAILED;
+                    break;
+                }
+                wear_leveling_async.erasing = true;
+            }
+            bool done = false;
+            if (!backing_store_erase_sector_poll(&done)) {
+                wl_dprintf("Failed to erase backing store sector\n");
+                wear_leveling_async.erasing = false;
+                status                      = WEAR_LEVELING_FAILED;
+                break;
+            }
+            if (!done) {
+                // Still erasing, check again on the next step
+                break;
+            }
+            wear_leveling_async.erasing = false;
+            wear_leveling_async.offset += (WEAR_LEVELING_SECTOR_SIZE);
+            if (wear_leveling_async.offset >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling_async.state          = CONSOLIDATION_COPYING;
+                wear_leveling_async.offset         = 0;
+                wear_leveling_async.hash           = FNV1A_64_INIT;
+                wear_leveling_async.modified.count = 0;
+            }
+        } break;
+
+        case CONSOLIDATION_COPYING: {
+            uint8_t *chunk = &wear_leveling.cache[wear_leveling_async.offset];
+            wear_leveling_stats.backing_writes += (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) / (BACKING_STORE_WRITE_SIZE);
+            if (!backing_store_write_bulk(target + wear_leveling_async.offset, (backing_store_int_t *)chunk, (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling_async.hash = fnv_64a_buf(chunk, (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE), wear_leveling_async.hash);
+            wear_leveling_async.offset += (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE);
+            if (wear_leveling_async.offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling_async.state = CONSOLIDATION_COMMITTING;
+            }
+        } break;
+
+        case CONSOLIDATION_COMMITTING:
+            status = wear_leveling_consolidation_commit();
+            break;
+    }
+
+    if (status == WEAR_LEVELING_FAILED) {
+        // Anything already written to the other bank can't be relied upon, so start over with the erase
+        wear_leveling_async.state  = CONSOLIDATION_ERASING;
+        wear_leveling_async.offset = 0;
+    }
+
+    if (wear_leveling_async.erasing) {
+        // The backing store can't be locked while the erase is in progress, so the step which completes it locks it instead
+        wear_leveling_async.relock |= lock_status == STATUS_SUCCESS;
+    } else if (lock_status == STATUS_SUCCESS || wear_leveling_async.relock) {
+        wear_leveling_async.relock = false;
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+    return status;
+}
+
+/**
+ * Waits for any sector erase started by the background consolidation to complete, so that the backing store can be
+ * accessed again.
+ */
+static void wear_leveling_consolidation_wait(void) {
+    while (wear_leveling_async.erasing) {
+        wear_leveling_consolidation_step();
+    }
+}
+
+/**
+ * Completes consolidation into the other bank without yielding, used when the write log is full.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    wl_dprintf("Consolidating in the foreground\n");
+    wear_leveling_consolidation_start();
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidation_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+    return status;
+}
+
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
@@ -478,8 +936,8 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_LOG_START);
+    while (!cancel_playback && address < WEAR_LEVELING_BANK_BASE + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
         bool                ok = backing_store_read(address, &value);
         if (!ok) {
@@ -618,6 +1076,12 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling_consolidation_wait();
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
+    memset(&wear_leveling_stats, 0, sizeof(wear_leveling_stats));
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -653,6 +1117,10 @@ wear_leveling_status_t wear_leveling_init(void) {
 wear_leveling_status_t wear_leveling_erase(void) {
     wl_dprintf("Erase\n");
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling_consolidation_wait();
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -661,6 +1129,7 @@ wear_leveling_status_t wear_leveling_erase(void) {
     }
 
     // Perform the erase
+    ++wear_leveling_stats.erases;
     bool ret = backing_store_erase();
     wear_leveling_clear_cache();
 
@@ -673,24 +1142,13 @@ wear_leveling_status_t wear_leveling_erase(void) {
 }
 
 /**
- * Writes logical data into the backing store. Skips writes if there are no changes to values.
+ * Appends logical data that is already present in the cache to the write log.
  */
-wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *value, size_t length) {
-    wl_assert(address + length <= (WEAR_LEVELING_LOGICAL_SIZE));
-    if (address + length > (WEAR_LEVELING_LOGICAL_SIZE)) {
-        return WEAR_LEVELING_FAILED;
-    }
-
-    wl_dprintf("Write ");
-    wl_dump(address, value, length);
-
-    // Skip write if there's no change compared to the current cached value
-    if (memcmp(value, &wear_leveling.cache[address], length) == 0) {
-        return true;
-    }
-
-    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
-    memcpy(&wear_leveling.cache[address], value, length);
+static wear_leveling_status_t wear_leveling_commit(const uint32_t address, const void *value, size_t length) {
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    wear_leveling_consolidation_wait();
+    wear_leveling_consolidation_track(address, length);
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
 
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
@@ -727,6 +1185,36 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Writes logical data into the backing store. Skips writes if there are no changes to values.
+ */
+wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *value, size_t length) {
+    wl_assert(address + length <= (WEAR_LEVELING_LOGICAL_SIZE));
+    if (address + length > (WEAR_LEVELING_LOGICAL_SIZE)) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Write ");
+    wl_dump(address, value, length);
+
+    // Skip write if there's no change compared to the current cached value
+    if (memcmp(value, &wear_leveling.cache[address], length) == 0) {
+        return true;
+    }
+
+    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
+    memcpy(&wear_leveling.cache[address], value, length);
+
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+    // Defer the write log update, so that repeated and neighbouring writes end up in as few log entries as possible
+    wear_leveling_range_set_add(&wear_leveling_dirty.pending, address, address + length);
+    wear_leveling_dirty.last_write = timer_read32();
+    return WEAR_LEVELING_SUCCESS;
+#else
+    return wear_leveling_commit(address, value, length);
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+}
+
 /**
  * Reads logical data from the cache.
  */
@@ -744,6 +1232,56 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+/**
+ * Appends any deferred writes to the write log.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+    while (wear_leveling_dirty.pending.count > 0) {
+        const wear_leveling_range_t *r = &wear_leveling_dirty.pending.ranges[wear_leveling_dirty.pending.count - 1];
+        wl_dprintf("Flush ");
+        wl_dump(r->start, &wear_leveling.cache[r->start], r->end - r->start);
+
+        status = wear_leveling_commit(r->start, &wear_leveling.cache[r->start], r->end - r->start);
+        if (status == WEAR_LEVELING_FAILED) {
+            // Keep the remaining ranges so that a later flush can retry
+            break;
+        }
+
+        --wear_leveling_dirty.pending.count;
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            // The entire cache has been written to the consolidated area, so every other range is stored as well.
+            wear_leveling_dirty.pending.count = 0;
+        }
+    }
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+    return status;
+}
+
+/**
+ * Appends deferred writes to the write log once writes have settled.
+ */
+void wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+    if (wear_leveling_dirty.pending.count > 0 && timer_elapsed32(wear_leveling_dirty.last_write) >= (WEAR_LEVELING_COMMIT_DELAY)) {
+        wear_leveling_flush();
+    }
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+    if (wear_leveling_async.state != CONSOLIDATION_IDLE) {
+        wear_leveling_consolidation_step();
+    }
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+}
+
+/**
+ * Retrieves the backing store activity counters.
+ */
+void wear_leveling_get_stats(wear_leveling_stats_t *stats) {
+    *stats = wear_leveling_stats;
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
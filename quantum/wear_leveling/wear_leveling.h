@@ -13,6 +13,16 @@ typedef enum wear_leveling_status_t {
     WEAR_LEVELING_CONSOLIDATED //< Invocation succeeded, consolidation occurred
 } wear_leveling_status_t;
 
+/**
+ * @typedef Backing store activity since initialization, used to gauge flash wear.
+ */
+typedef struct wear_leveling_stats_t {
+    uint32_t log_entries;    //< Number of entries appended to the write log
+    uint32_t backing_writes; //< Number of backing store write operations, including consolidation
+    uint32_t consolidations; //< Number of times the write log was consolidated
+    uint32_t erases;         //< Number of backing store erase cycles
+} wear_leveling_stats_t;
+
 /**
  * Wear-leveling initialization
  *
@@ -52,3 +62,25 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Appends any writes deferred by WEAR_LEVELING_DEFERRED_COMMIT to the write log.
+ *
+ * Does nothing if writes are not deferred.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Periodic task, appends deferred writes to the write log once no write has occurred for WEAR_LEVELING_COMMIT_DELAY,
+ * and performs the next step of a background consolidation.
+ */
+void wear_leveling_task(void);
+
+/**
+ * Retrieves the backing store activity counters.
+ *
+ * @param stats[out] the counters accumulated since wear_leveling_init()
+ */
+void wear_leveling_get_stats(wear_leveling_stats_t* stats);
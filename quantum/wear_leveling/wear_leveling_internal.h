@@ -25,6 +25,39 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+#    ifndef WEAR_LEVELING_SECTOR_SIZE
+#        error WEAR_LEVELING_SECTOR_SIZE was not set.
+#    endif
+#    ifndef WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE 64
+#    endif
+// The backing store is split into two banks, each with its own consolidated data, header and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+// FNV1a_64 of the consolidated data and the sequence number, followed by the sequence number of the bank
+#    define WEAR_LEVELING_HEADER_SIZE 16
+#    ifndef WEAR_LEVELING_CONSOLIDATION_RESERVE
+#        define WEAR_LEVELING_CONSOLIDATION_RESERVE (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - (WEAR_LEVELING_HEADER_SIZE)) / 2)
+#    endif
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+// FNV1a_64 of the consolidated data
+#    define WEAR_LEVELING_HEADER_SIZE 8
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+
+// The write log follows the consolidated data and its header
+#define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_HEADER_SIZE))
+
+#ifdef WEAR_LEVELING_DEFERRED_COMMIT
+#    ifndef WEAR_LEVELING_COMMIT_DELAY
+#        define WEAR_LEVELING_COMMIT_DELAY 500
+#    endif
+#endif // WEAR_LEVELING_DEFERRED_COMMIT
+
+#ifndef WEAR_LEVELING_DIRTY_RANGES
+#    define WEAR_LEVELING_DIRTY_RANGES 8
+#endif
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -63,6 +96,13 @@ typedef uint64_t backing_store_int_t;
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 STATIC_ASSERT(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+STATIC_ASSERT(WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_SECTOR_SIZE == 0, "Each half of the backing store must be a multiple of the sector size");
+STATIC_ASSERT(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Each half of the backing store must be at least twice the size of the logical size");
+STATIC_ASSERT(WEAR_LEVELING_LOGICAL_SIZE % WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE == 0, "Logical size must be a multiple of the consolidation chunk size");
+STATIC_ASSERT(WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation chunk size must be a multiple of write size");
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
+STATIC_ASSERT(WEAR_LEVELING_DIRTY_RANGES > 0 && WEAR_LEVELING_DIRTY_RANGES <= 255, "Dirty range count must be between 1 and 255");
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
@@ -73,6 +113,10 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_ASYNC_CONSOLIDATION
+bool backing_store_erase_sector_start(uint32_t address); // starts erasing WEAR_LEVELING_SECTOR_SIZE bytes at the supplied address, required for background consolidation
+bool backing_store_erase_sector_poll(bool* done);       // sets done once the erase has completed, no other backing store access is permitted before then
+#endif // WEAR_LEVELING_ASYNC_CONSOLIDATION
 
 /**
  * Helper type used to contain a write log entry.
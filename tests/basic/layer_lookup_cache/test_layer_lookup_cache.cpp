@@ -0,0 +1,158 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+#define TEST_LAYERS 6
+
+class LayerLookupCache : public TestFixture {
+   protected:
+    /* Fills every position of the first TEST_LAYERS layers, mostly transparent above layer 0. */
+    void populate_keymap(uint32_t seed) {
+        for (uint8_t layer = 0; layer < TEST_LAYERS; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    seed              = seed * 1103515245 + 12345;
+                    bool     opaque   = layer == 0 || ((seed >> 16) % 4) == 0;
+                    uint16_t keycode  = opaque ? (uint16_t)(KC_A + ((seed >> 8) % 26)) : KC_TRNS;
+                    add_key(KeymapKey(layer, col, row, keycode));
+                }
+            }
+        }
+    }
+
+    /* Reference implementation: the uncached top-down layer walk. */
+    static uint8_t walk_layers(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if (layers & ((layer_state_t)1 << i)) {
+                if (action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                    return i;
+                }
+            }
+        }
+        return 0;
+    }
+
+    void expect_all_keys_match_walk() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), walk_layers(key)) << "row " << +row << " col " << +col << " layer_state " << layer_state << " default_layer_state " << default_layer_state;
+            }
+        }
+    }
+};
+
+TEST_F(LayerLookupCache, MatchesLayerWalkForAllLayerStates) {
+    TestDriver driver;
+
+    populate_keymap(0x1234);
+
+    for (layer_state_t default_state : {(layer_state_t)0, (layer_state_t)1, (layer_state_t)0b10, (layer_state_t)0b1001}) {
+        default_layer_set(default_state);
+        for (layer_state_t state = 0; state < ((layer_state_t)1 << TEST_LAYERS); state++) {
+            layer_state_set(state);
+            expect_all_keys_match_walk();
+            /* Second pass is served from the cache. */
+            expect_all_keys_match_walk();
+        }
+    }
+
+    default_layer_set(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, FollowsDirectLayerStateAssignment) {
+    TestDriver driver;
+
+    populate_keymap(0xBEEF);
+
+    layer_state_set(0b000110);
+    expect_all_keys_match_walk();
+
+    /* Some code paths assign the layer state without going through layer_state_set(). */
+    layer_state = 0b101000;
+    expect_all_keys_match_walk();
+    default_layer_state = 0b10;
+    expect_all_keys_match_walk();
+
+    default_layer_state = 1;
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, FollowsKeymapChanges) {
+    TestDriver driver;
+    KeymapKey  base_key  = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  upper_key = KeymapKey(1, 0, 0, KC_TRNS);
+
+    set_keymap({base_key, upper_key});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 0);
+
+    /* Replacing the keymap must drop previously resolved entries. */
+    set_keymap({base_key, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 1);
+
+    layer_lookup_cache_invalidate();
+    EXPECT_EQ(layer_switch_get_layer(base_key.position), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, MomentaryLayerKeyUsesResolvedLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key   = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, KeymapKey(1, 0, 0, KC_TRNS), regular_key, KeymapKey(1, 1, 0, KC_B)});
+
+    /* Prime the cache for the base layer. */
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Releasing the layer key first must still release the key from its source layer. */
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
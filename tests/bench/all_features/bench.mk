@@ -0,0 +1,23 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains benchmarks
+# --------------------------------------------------------------------------------
+
+COMBO_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+KEY_OVERRIDE_ENABLE = yes
+AUTO_SHIFT_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+REPEAT_KEY_ENABLE = yes
+KEY_LOCK_ENABLE = yes
+DYNAMIC_MACRO_ENABLE = yes
+DYNAMIC_TAPPING_TERM_ENABLE = yes
+LEADER_ENABLE = yes
+LAYER_LOCK_ENABLE = yes
+TRI_LAYER_ENABLE = yes
+SECURE_ENABLE = yes
+UNICODE_ENABLE = yes
+PROGRAMMABLE_BUTTON_ENABLE = yes
+INTROSPECTION_KEYMAP_C = bench_keymap.c
@@ -0,0 +1,47 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchAllFeatures : public BenchFixture {
+   protected:
+    void SetUp() override {
+        map_alpha_keys();
+        add_key(shift);
+        add_key(backspace);
+        add_key(esc_caps);
+        add_key(caps_word);
+    }
+
+    const KeymapKey& key(char c) {
+        return alpha_keys[c - 'a'];
+    }
+
+    KeymapKey shift{0, 0, 3, KC_LSFT};
+    KeymapKey backspace{0, 1, 3, KC_BSPC};
+    KeymapKey esc_caps{0, 2, 3, TD(0)};
+    KeymapKey caps_word{0, 3, 3, CW_TOGG};
+};
+
+TEST_F(BenchAllFeatures, typing) {
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("all_features_typing", stream, 200);
+}
+
+TEST_F(BenchAllFeatures, mixed) {
+    BenchStream stream;
+    type(stream, "mixed ");
+    stream.chord({key('j'), key('k')}, 20, 30);
+    stream.chord({key('s'), key('d'), key('f')}, 20, 30);
+    stream.tap(esc_caps, 20, 30).tap(esc_caps, 20, TAPPING_TERM + 10);
+    stream.press(shift, 10).tap(backspace, 20, 30).release(shift, 10);
+    stream.tap(caps_word, 20, 30);
+    type(stream, "word ");
+    stream.tap(key('a'), AUTO_SHIFT_TIMEOUT + 20, 30);
+    type(stream, "end ");
+
+    run_stream("all_features_mixed", stream, 200);
+}
@@ -0,0 +1,34 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { jk_esc, df_tab, sdf_ctl };
+
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const sdf_combo[] = {KC_S, KC_D, KC_F, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [jk_esc]  = COMBO(jk_combo, KC_ESC),
+    [df_tab]  = COMBO(df_combo, KC_TAB),
+    [sdf_ctl] = COMBO(sdf_combo, KC_LCTL)
+};
+// clang-format on
+
+enum tap_dances { TD_ESC_CAPS };
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_ESC_CAPS] = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS)
+};
+// clang-format on
+
+const key_override_t delete_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &delete_key_override
+};
+// clang-format on
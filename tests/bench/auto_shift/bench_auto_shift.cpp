@@ -0,0 +1,30 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchAutoShift : public BenchFixture {};
+
+TEST_F(BenchAutoShift, typing) {
+    map_alpha_keys();
+
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("auto_shift_typing", stream, 200);
+}
+
+TEST_F(BenchAutoShift, shifted_holds) {
+    map_alpha_keys();
+
+    // Every other letter is held past the auto shift timeout.
+    BenchStream stream;
+    const char *text = "autoshift";
+    for (const char *c = text; *c; c++) {
+        stream.tap(alpha_keys[*c - 'a'], (c - text) % 2 ? AUTO_SHIFT_TIMEOUT + 20 : 20, 30);
+    }
+    type(stream, " ");
+
+    run_stream("auto_shift_holds", stream, 200);
+}
@@ -0,0 +1,55 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include <cstring>
+#include "test_common.hpp"
+
+class BenchBasic : public BenchFixture {};
+
+TEST_F(BenchBasic, typing) {
+    map_alpha_keys();
+
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("basic_typing", stream, 200);
+}
+
+TEST_F(BenchBasic, rolling_typing) {
+    map_alpha_keys();
+
+    // Overlapping key presses, as produced by fast typists.
+    BenchStream stream;
+    for (const char *word : {"the", "quick", "brown", "fox"}) {
+        for (const char *c = word; *c; c++) {
+            stream.press(alpha_keys[*c - 'a'], 10);
+            if (c != word) {
+                stream.release(alpha_keys[c[-1] - 'a'], 10);
+            }
+        }
+        stream.release(alpha_keys[word[strlen(word) - 1] - 'a'], 10);
+        stream.tap(alpha_keys[26], 10, 10);
+    }
+
+    run_stream("basic_rolling", stream, 500);
+}
+
+TEST_F(BenchBasic, layers) {
+    map_alpha_keys();
+    KeymapKey layer_key(0, 7, 2, MO(1));
+    add_key(layer_key);
+    for (uint8_t i = 0; i < 10; i++) {
+        add_key(KeymapKey(1, i, 0, KC_1 + i));
+    }
+
+    BenchStream stream;
+    stream.press(layer_key, 5);
+    for (uint8_t i = 0; i < 10; i++) {
+        stream.tap(alpha_keys[i], 10, 10);
+    }
+    stream.release(layer_key, 5);
+    type(stream, "layer ");
+
+    run_stream("basic_layers", stream, 500);
+}
@@ -0,0 +1,33 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchCapsWord : public BenchFixture {};
+
+TEST_F(BenchCapsWord, typing) {
+    map_alpha_keys();
+    add_key(KeymapKey(0, 0, 3, CW_TOGG));
+
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("caps_word_typing", stream, 200);
+}
+
+TEST_F(BenchCapsWord, words) {
+    map_alpha_keys();
+    KeymapKey caps_word(0, 0, 3, CW_TOGG);
+    add_key(caps_word);
+
+    // Caps word is turned on for every other word and ends on the following space.
+    BenchStream stream;
+    for (const char *word : {"qmk ", "is ", "firmware ", "for ", "keyboards "}) {
+        stream.tap(caps_word, 20, 30);
+        type(stream, word);
+        type(stream, "and ");
+    }
+
+    run_stream("caps_word_words", stream, 200);
+}
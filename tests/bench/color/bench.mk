@@ -0,0 +1,8 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains benchmarks
+# --------------------------------------------------------------------------------
+
+SRC += $(QUANTUM_DIR)/color.c
@@ -0,0 +1,58 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+// Converts every HSV value once per round, scalar or batched in LED sized chunks.
+class BenchColor : public ::testing::Test {
+   protected:
+    static constexpr int rounds = 4;
+    static constexpr int chunk  = 8;
+
+    void SetUp() override {
+        for (int i = 0; i < 256 * 256; i++) {
+            hsv[i] = {(uint8_t)(i * 7), (uint8_t)(i >> 8), (uint8_t)i};
+        }
+    }
+
+    template <typename F>
+    void run(const std::string &name, F convert) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < 256 * 256; i += chunk) {
+                convert(&hsv[i], &rgb[i], chunk);
+            }
+        }
+        auto     end     = std::chrono::steady_clock::now();
+        uint64_t colors  = (uint64_t)rounds * 256 * 256;
+        double   elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        // Keep the conversions from being optimised away
+        uint32_t checksum = 0;
+        for (int i = 0; i < 256 * 256; i++) {
+            checksum += rgb[i].r + rgb[i].g + rgb[i].b;
+        }
+
+        RecordProperty(name + "_ns_per_color", std::to_string(elapsed / colors));
+        printf("[ BENCH    ] %-24s %10llu colors %12.0f colors/s %9.2f ns/color  checksum %08x\n", name.c_str(), (unsigned long long)colors, colors * 1e9 / elapsed, elapsed / colors, (unsigned)checksum);
+    }
+
+    hsv_t hsv[256 * 256];
+    rgb_t rgb[256 * 256];
+};
+
+TEST_F(BenchColor, hsv_to_rgb) {
+    run("hsv_to_rgb_scalar", [](const hsv_t *hsv, rgb_t *rgb, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb(hsv[i]);
+        }
+    });
+    run("hsv_to_rgb_batch", hsv_to_rgb_batch);
+}
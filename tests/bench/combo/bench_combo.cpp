@@ -0,0 +1,36 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchCombo : public BenchFixture {
+   protected:
+    const KeymapKey& key(char c) {
+        return alpha_keys[c - 'a'];
+    }
+};
+
+TEST_F(BenchCombo, typing) {
+    map_alpha_keys();
+
+    // Most letters are not part of a combo, the ones that are get buffered until resolved.
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("combo_typing", stream, 200);
+}
+
+TEST_F(BenchCombo, chords) {
+    map_alpha_keys();
+
+    BenchStream stream;
+    stream.chord({key('j'), key('k')}, 20, 30);
+    stream.chord({key('d'), key('f')}, 20, 30);
+    stream.chord({key('w'), key('e')}, 20, 30);
+    stream.chord({key('i'), key('o')}, 20, 30);
+    stream.chord({key('s'), key('d'), key('f')}, 20, 30);
+    type(stream, "wide ");
+
+    run_stream("combo_chords", stream, 500);
+}
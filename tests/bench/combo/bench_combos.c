@@ -0,0 +1,22 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { jk_esc, df_tab, we_bspc, io_ent, sdf_ctl };
+
+uint16_t const jk_combo[]  = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[]  = {KC_D, KC_F, COMBO_END};
+uint16_t const we_combo[]  = {KC_W, KC_E, COMBO_END};
+uint16_t const io_combo[]  = {KC_I, KC_O, COMBO_END};
+uint16_t const sdf_combo[] = {KC_S, KC_D, KC_F, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [jk_esc]  = COMBO(jk_combo, KC_ESC),
+    [df_tab]  = COMBO(df_combo, KC_TAB),
+    [we_bspc] = COMBO(we_combo, KC_BSPC),
+    [io_ent]  = COMBO(io_combo, KC_ENT),
+    [sdf_ctl] = COMBO(sdf_combo, KC_LCTL)
+};
+// clang-format on
@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchKeyOverride : public BenchFixture {
+   protected:
+    void SetUp() override {
+        map_alpha_keys();
+        add_key(shift);
+        add_key(backspace);
+        add_key(comma);
+    }
+
+    KeymapKey shift{0, 0, 3, KC_LSFT};
+    KeymapKey backspace{0, 1, 3, KC_BSPC};
+    KeymapKey comma{0, 2, 3, KC_COMM};
+};
+
+TEST_F(BenchKeyOverride, typing) {
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("key_override_typing", stream, 200);
+}
+
+TEST_F(BenchKeyOverride, overrides) {
+    // Shifted letters pass through, shifted backspace and comma are replaced.
+    BenchStream stream;
+    stream.press(shift, 10);
+    type(stream, "qmk");
+    stream.tap(backspace, 20, 30).tap(comma, 20, 30);
+    stream.release(shift, 10);
+    stream.tap(backspace, 20, 30).tap(comma, 20, 30);
+    type(stream, "done ");
+
+    run_stream("key_override_overrides", stream, 500);
+}
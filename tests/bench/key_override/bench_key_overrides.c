@@ -0,0 +1,16 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const key_override_t delete_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t comma_key_override  = ko_make_basic(MOD_MASK_SHIFT, KC_COMM, KC_SCLN);
+const key_override_t dot_key_override    = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, KC_COLN);
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &delete_key_override,
+    &comma_key_override,
+    &dot_key_override
+};
+// clang-format on
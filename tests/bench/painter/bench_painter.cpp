@@ -0,0 +1,579 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "qgf.h"
+#include "qff.h"
+#include "qp_internal_driver.h"
+#include "qp_comms_dummy.h"
+
+void qp_internal_animation_tick(void);
+void advance_time(uint32_t ms);
+}
+
+// Stand-in for an RGB565 display, counting what gets sent to it and keeping a copy of the pixels it receives
+struct CountingDisplay {
+    painter_driver_t      base; // must be first, so this object can be cast from the painter_device_t type
+    uint16_t              l, t, r, b, x, y;
+    uint64_t              viewports;
+    uint64_t              bytes;
+    std::vector<uint16_t> pixels;
+
+    static bool init(painter_device_t device, painter_rotation_t rotation) {
+        return true;
+    }
+
+    static bool power(painter_device_t device, bool power_on) {
+        return true;
+    }
+
+    static bool clear(painter_device_t device) {
+        return true;
+    }
+
+    static bool flush(painter_device_t device) {
+        return true;
+    }
+
+    static bool viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+        CountingDisplay *display = (CountingDisplay *)device;
+        display->l = display->x = left;
+        display->t = display->y = top;
+        display->r              = right;
+        display->b              = bottom;
+        display->viewports++;
+        return true;
+    }
+
+    static bool pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+        CountingDisplay *display = (CountingDisplay *)device;
+        const uint16_t  *data    = (const uint16_t *)pixel_data;
+        for (uint32_t i = 0; i < native_pixel_count; i++) {
+            display->pixels[display->y * display->base.panel_width + display->x] = data[i];
+            if (++display->x > display->r) {
+                display->x = display->l;
+                if (++display->y > display->b) {
+                    display->y = display->t;
+                }
+            }
+        }
+        display->bytes += native_pixel_count * sizeof(uint16_t);
+        return true;
+    }
+
+    static bool palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+        return true;
+    }
+
+    static bool append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+        return true;
+    }
+
+    static bool append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+        return true;
+    }
+
+    static const painter_driver_vtable_t vtable;
+
+    CountingDisplay(uint16_t width, uint16_t height) : base{}, l(0), t(0), r(0), b(0), x(0), y(0), viewports(0), bytes(0), pixels(width * height) {
+        base.driver_vtable         = &vtable;
+        base.comms_vtable          = &dummy_comms_vtable;
+        base.panel_width           = width;
+        base.panel_height          = height;
+        base.native_bits_per_pixel = 16;
+    }
+};
+
+const painter_driver_vtable_t CountingDisplay::vtable = {init, power, clear, flush, viewport, pixdata, palette_convert, append_pixels, append_pixdata};
+
+// Draws full-surface images in the various QGF formats onto an RGB565 surface, which streams through the dummy comms driver.
+class BenchPainter : public ::testing::Test {
+   protected:
+    static constexpr uint16_t width  = 240;
+    static constexpr uint16_t height = 80;
+    static constexpr int      rounds = 200;
+
+    // Surfaces can't be released again, so all benchmarks share the same one
+    static void SetUpTestSuite() {
+        surface = qp_make_rgb565_surface(width, height, buffer);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    }
+
+    static void put16(std::vector<uint8_t> &out, uint16_t value) {
+        out.push_back(value & 0xFF);
+        out.push_back(value >> 8);
+    }
+
+    static void put32(std::vector<uint8_t> &out, uint32_t value) {
+        put16(out, value & 0xFFFF);
+        put16(out, value >> 16);
+    }
+
+    static void put_block_header(std::vector<uint8_t> &out, uint8_t type_id, uint32_t length) {
+        out.push_back(type_id);
+        out.push_back(~type_id);
+        out.push_back(length & 0xFF);
+        out.push_back((length >> 8) & 0xFF);
+        out.push_back((length >> 16) & 0xFF);
+    }
+
+    // Same scheme as the QMK CLI: 0-127 repeats the next byte, 128-255 is followed by (n - 127) literal bytes
+    static std::vector<uint8_t> compress_rle(const std::vector<uint8_t> &data) {
+        std::vector<uint8_t> out;
+        size_t               n = 0;
+        while (n < data.size()) {
+            size_t run = 1;
+            while (n + run < data.size() && run < 127 && data[n + run] == data[n]) {
+                run++;
+            }
+            if (run >= 2) {
+                out.push_back(run);
+                out.push_back(data[n]);
+                n += run;
+                continue;
+            }
+            size_t literal = 1;
+            while (n + literal < data.size() && literal < 128 && !(n + literal + 1 < data.size() && data[n + literal] == data[n + literal + 1])) {
+                literal++;
+            }
+            out.push_back(127 + literal);
+            out.insert(out.end(), data.begin() + n, data.begin() + n + literal);
+            n += literal;
+        }
+        return out;
+    }
+
+    // Builds a single-frame QGF image in memory
+    static std::vector<uint8_t> make_qgf(qp_image_format_t format, uint8_t bpp, bool has_palette, painter_compression_t compression, const std::vector<uint8_t> &pixels) {
+        std::vector<uint8_t> data = compression == IMAGE_COMPRESSED_RLE ? compress_rle(pixels) : pixels;
+        std::vector<uint8_t> out;
+
+        put_block_header(out, QGF_GRAPHICS_DESCRIPTOR_TYPEID, 18);
+        out.push_back(QGF_MAGIC & 0xFF);
+        out.push_back((QGF_MAGIC >> 8) & 0xFF);
+        out.push_back((QGF_MAGIC >> 16) & 0xFF);
+        out.push_back(0x01);
+        size_t size_pos = out.size();
+        put32(out, 0);
+        put32(out, 0);
+        put16(out, width);
+        put16(out, height);
+        put16(out, 1);
+
+        put_block_header(out, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, sizeof(uint32_t));
+        put32(out, out.size() + sizeof(uint32_t));
+
+        put_block_header(out, QGF_FRAME_DESCRIPTOR_TYPEID, 6);
+        out.push_back(format);
+        out.push_back(0);
+        out.push_back(compression);
+        out.push_back(0);
+        put16(out, 0);
+
+        if (has_palette) {
+            put_block_header(out, QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, (1 << bpp) * 3);
+            for (int i = 0; i < (1 << bpp); i++) {
+                out.push_back(i * 37);
+                out.push_back(255 - i);
+                out.push_back(128 + i / 2);
+            }
+        }
+
+        put_block_header(out, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+        out.insert(out.end(), data.begin(), data.end());
+
+        uint32_t total = out.size();
+        for (int i = 0; i < 4; i++) {
+            out[size_pos + i]     = (total >> (8 * i)) & 0xFF;
+            out[size_pos + 4 + i] = (~total >> (8 * i)) & 0xFF;
+        }
+        return out;
+    }
+
+    // Pixel data for a status-screen style image: flat bands with some detail, so RLE has runs to work with
+    static std::vector<uint8_t> make_pixels(uint8_t bpp, bool noisy) {
+        std::vector<uint8_t> pixels(width * height * bpp / 8);
+        uint32_t             seed = 0x1234567;
+        for (size_t i = 0; i < pixels.size(); i++) {
+            size_t row = i / (width * bpp / 8);
+            if (noisy) {
+                seed      = seed * 1103515245 + 12345;
+                pixels[i] = seed >> 16;
+            } else {
+                pixels[i] = (row / 10) * 0x11 + ((i % 97) == 0 ? 1 : 0);
+            }
+        }
+        return pixels;
+    }
+
+    std::vector<uint8_t> draw(const std::string &name, qp_image_format_t format, uint8_t bpp, bool has_palette, painter_compression_t compression, bool noisy) {
+        std::vector<uint8_t>   qgf   = make_qgf(format, bpp, has_palette, compression, make_pixels(bpp, noisy));
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        EXPECT_NE(image, nullptr) << name << ": image failed to load";
+        if (image == nullptr) {
+            return {};
+        }
+
+        EXPECT_TRUE(qp_drawimage(surface, 0, 0, image)) << name << ": drawing failed";
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            qp_drawimage(surface, 0, 0, image);
+        }
+        auto end = std::chrono::steady_clock::now();
+        qp_close_image(image);
+
+        uint64_t pixels  = (uint64_t)rounds * width * height;
+        double   elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        uint32_t checksum = 0;
+        for (size_t i = 0; i < sizeof(buffer); i++) {
+            checksum = checksum * 31 + buffer[i];
+        }
+
+        RecordProperty(name + "_ns_per_pixel", std::to_string(elapsed / pixels));
+        printf("[ BENCH    ] %-24s %8zu bytes %12.0f pixels/s %9.2f ns/pixel  checksum %08x\n", name.c_str(), qgf.size(), pixels * 1e9 / elapsed, elapsed / pixels, (unsigned)checksum);
+        return std::vector<uint8_t>(buffer, buffer + sizeof(buffer));
+    }
+
+    // Builds an uncompressed 1bpp QFF font with an ASCII table, each glyph filled with a distinct bit pattern
+    static std::vector<uint8_t> make_qff(uint8_t line_height, std::vector<std::vector<uint8_t>> &glyphs, std::vector<uint8_t> &widths) {
+        std::vector<uint8_t> out;
+        std::vector<uint8_t> data;
+        uint32_t             seed = 0x7654321;
+
+        put_block_header(out, QFF_FONT_DESCRIPTOR_TYPEID, 20);
+        out.push_back(QFF_MAGIC & 0xFF);
+        out.push_back((QFF_MAGIC >> 8) & 0xFF);
+        out.push_back((QFF_MAGIC >> 16) & 0xFF);
+        out.push_back(0x01);
+        size_t size_pos = out.size();
+        put32(out, 0);
+        put32(out, 0);
+        out.push_back(line_height);
+        out.push_back(1);
+        put16(out, 0);
+        out.push_back(GRAYSCALE_1BPP);
+        out.push_back(0);
+        out.push_back(IMAGE_UNCOMPRESSED);
+        out.push_back(0);
+
+        put_block_header(out, QFF_ASCII_GLYPH_DESCRIPTOR_TYPEID, 95 * 3);
+        glyphs.clear();
+        widths.clear();
+        for (int c = 0; c < 95; c++) {
+            uint8_t              glyph_width = 6 + c % 4;
+            std::vector<uint8_t> glyph((glyph_width * line_height + 7) / 8);
+            for (auto &byte : glyph) {
+                seed = seed * 1103515245 + 12345;
+                byte = seed >> 16;
+            }
+            uint32_t value = glyph_width | (data.size() << QFF_GLYPH_WIDTH_BITS);
+            out.push_back(value & 0xFF);
+            out.push_back((value >> 8) & 0xFF);
+            out.push_back((value >> 16) & 0xFF);
+            data.insert(data.end(), glyph.begin(), glyph.end());
+            glyphs.push_back(glyph);
+            widths.push_back(glyph_width);
+        }
+
+        put_block_header(out, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+        out.insert(out.end(), data.begin(), data.end());
+
+        uint32_t total = out.size();
+        for (int i = 0; i < 4; i++) {
+            out[size_pos + i]     = (total >> (8 * i)) & 0xFF;
+            out[size_pos + 4 + i] = (~total >> (8 * i)) & 0xFF;
+        }
+        return out;
+    }
+
+    // Status-screen style animation frames: flat bands with three indicators changing colour at different rates
+    static std::vector<std::vector<uint8_t>> make_indicator_frames(uint16_t frame_count) {
+        static const uint16_t                      colors[]   = {0xF800, 0x07E0, 0x001F, 0xFFE0};
+        static const std::array<uint16_t, 2>       indicators[] = {{16, 16}, {208, 48}, {112, 32}};
+        std::vector<std::vector<uint8_t>>          frames;
+        for (uint16_t f = 0; f < frame_count; f++) {
+            std::vector<uint8_t> pixels = make_pixels(16, false);
+            for (int k = 0; k < 3; k++) {
+                uint16_t color = colors[(f >> k) % 4];
+                for (uint16_t y = indicators[k][1]; y < indicators[k][1] + 16; y++) {
+                    for (uint16_t x = indicators[k][0]; x < indicators[k][0] + 16; x++) {
+                        pixels[(y * width + x) * 2]     = color >> 8;
+                        pixels[(y * width + x) * 2 + 1] = color & 0xFF;
+                    }
+                }
+            }
+            frames.push_back(pixels);
+        }
+        return frames;
+    }
+
+    // Rectangles covering the 16x16 tiles that differ between two frames, as {left, top, right, bottom}
+    static std::vector<std::array<uint16_t, 4>> changed_tiles(const std::vector<uint8_t> &prev, const std::vector<uint8_t> &next) {
+        std::vector<std::array<uint16_t, 4>> rects;
+        for (uint16_t top = 0; top < height; top += 16) {
+            for (uint16_t left = 0; left < width; left += 16) {
+                bool changed = false;
+                for (uint16_t y = top; y < top + 16 && !changed; y++) {
+                    changed = memcmp(&prev[(y * width + left) * 2], &next[(y * width + left) * 2], 16 * 2) != 0;
+                }
+                if (changed) {
+                    rects.push_back({left, top, (uint16_t)(left + 15), (uint16_t)(top + 15)});
+                }
+            }
+        }
+        return rects;
+    }
+
+    // Builds an uncompressed RGB565 animation in memory. Frames after the first only contain the changed tiles, either
+    // as one delta rectangle around all of them or as one rectangle per tile.
+    static std::vector<uint8_t> make_animation(const std::vector<std::vector<uint8_t>> &frames, bool delta_rects, uint64_t &pixels_per_cycle) {
+        std::vector<uint8_t> out;
+
+        put_block_header(out, QGF_GRAPHICS_DESCRIPTOR_TYPEID, 18);
+        out.push_back(QGF_MAGIC & 0xFF);
+        out.push_back((QGF_MAGIC >> 8) & 0xFF);
+        out.push_back((QGF_MAGIC >> 16) & 0xFF);
+        out.push_back(0x01);
+        size_t size_pos = out.size();
+        put32(out, 0);
+        put32(out, 0);
+        put16(out, width);
+        put16(out, height);
+        put16(out, frames.size());
+
+        put_block_header(out, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, frames.size() * sizeof(uint32_t));
+        size_t offsets_pos = out.size();
+        out.resize(out.size() + frames.size() * sizeof(uint32_t));
+
+        pixels_per_cycle = 0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            for (int b = 0; b < 4; b++) {
+                out[offsets_pos + i * 4 + b] = (out.size() >> (8 * b)) & 0xFF;
+            }
+
+            std::vector<std::array<uint16_t, 4>> rects = {{0, 0, width - 1, height - 1}};
+            if (i > 0) {
+                rects = changed_tiles(frames[i - 1], frames[i]);
+                if (!delta_rects) {
+                    std::array<uint16_t, 4> bbox = rects[0];
+                    for (const auto &rect : rects) {
+                        bbox = {std::min(bbox[0], rect[0]), std::min(bbox[1], rect[1]), std::max(bbox[2], rect[2]), std::max(bbox[3], rect[3])};
+                    }
+                    rects = {bbox};
+                }
+            }
+
+            put_block_header(out, QGF_FRAME_DESCRIPTOR_TYPEID, 6);
+            out.push_back(RGB565_16BPP);
+            out.push_back(i == 0 ? 0 : (delta_rects ? QGF_FRAME_FLAG_DELTA | QGF_FRAME_FLAG_DELTA_RECTS : QGF_FRAME_FLAG_DELTA));
+            out.push_back(IMAGE_UNCOMPRESSED);
+            out.push_back(0);
+            put16(out, 10);
+
+            if (i > 0) {
+                put_block_header(out, delta_rects ? QGF_FRAME_DELTA_RECTS_DESCRIPTOR_TYPEID : QGF_FRAME_DELTA_DESCRIPTOR_TYPEID, rects.size() * 8);
+                for (const auto &rect : rects) {
+                    for (uint16_t value : rect) {
+                        put16(out, value);
+                    }
+                }
+            }
+
+            std::vector<uint8_t> data;
+            for (const auto &rect : rects) {
+                for (uint16_t y = rect[1]; y <= rect[3]; y++) {
+                    data.insert(data.end(), frames[i].begin() + (y * width + rect[0]) * 2, frames[i].begin() + (y * width + rect[2] + 1) * 2);
+                }
+            }
+            put_block_header(out, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+            out.insert(out.end(), data.begin(), data.end());
+            pixels_per_cycle += data.size() / 2;
+        }
+
+        uint32_t total = out.size();
+        for (int i = 0; i < 4; i++) {
+            out[size_pos + i]     = (total >> (8 * i)) & 0xFF;
+            out[size_pos + 4 + i] = (~total >> (8 * i)) & 0xFF;
+        }
+        return out;
+    }
+
+    // Plays the animation, checking each frame as it's shown, then times complete animation cycles
+    void animate(const std::string &name, const std::vector<std::vector<uint8_t>> &frames, bool delta_rects) {
+        uint64_t               pixels_per_cycle;
+        std::vector<uint8_t>   qgf   = make_animation(frames, delta_rects, pixels_per_cycle);
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr) << name << ": image failed to load";
+
+        deferred_token token = qp_animate(surface, 0, 0, image);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN) << name << ": animation failed to start";
+        for (size_t i = 1; i <= frames.size(); i++) {
+            advance_time(10);
+            qp_internal_animation_tick();
+            ASSERT_EQ(std::vector<uint8_t>(buffer, buffer + sizeof(buffer)), frames[i % frames.size()]) << name << ": mismatch on frame " << i;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++) {
+            for (size_t i = 0; i < frames.size(); i++) {
+                advance_time(10);
+                qp_internal_animation_tick();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        qp_stop_animation(token);
+        qp_close_image(image);
+
+        double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        RecordProperty(name + "_ns_per_cycle", std::to_string(elapsed / rounds));
+        printf("[ BENCH    ] %-24s %8zu bytes %8llu pixels/cycle %12.0f ns/cycle\n", name.c_str(), qgf.size(), (unsigned long long)pixels_per_cycle, elapsed / rounds);
+    }
+
+    // Repeatedly redraws a few small areas of the surface, counting what each transfer to the display costs
+    template <typename F>
+    void hud(const std::string &name, F update) {
+        // Clean surfaces aren't transferred at all, so start from a freshly initialised one to bring the display in sync
+        CountingDisplay display(width, height);
+        ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(&display, QP_ROTATION_0));
+        ASSERT_TRUE(qp_surface_draw(surface, &display, 0, 0, true));
+        display.viewports = display.bytes = 0;
+
+        double elapsed = 0;
+        for (int r = 0; r < rounds; r++) {
+            update(r);
+            auto start = std::chrono::steady_clock::now();
+            ASSERT_TRUE(qp_surface_draw(surface, &display, 0, 0, false));
+            elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            ASSERT_EQ(memcmp(display.pixels.data(), buffer, sizeof(buffer)), 0) << name << ": mismatch on update " << r;
+        }
+
+        // Setting a viewport on the common SPI panels takes CASET, RASET and RAMWR, 11 bytes in all
+        double bytes = (display.bytes + display.viewports * 11) / (double)rounds;
+        RecordProperty(name + "_bytes_per_update", std::to_string(bytes));
+        printf("[ BENCH    ] %-24s %8.0f bytes/update %6.2f viewports/update %12.0f ns/update\n", name.c_str(), bytes, display.viewports / (double)rounds, elapsed / rounds);
+    }
+
+    static painter_device_t surface;
+    static uint8_t          buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(width, height, 16)];
+};
+
+painter_device_t BenchPainter::surface;
+uint8_t          BenchPainter::buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(width, height, 16)];
+
+TEST_F(BenchPainter, Grayscale1bpp) {
+    auto raw = draw("mono1_raw", GRAYSCALE_1BPP, 1, false, IMAGE_UNCOMPRESSED, true);
+    EXPECT_EQ(draw("mono1_rle", GRAYSCALE_1BPP, 1, false, IMAGE_COMPRESSED_RLE, true), raw);
+    raw = draw("mono1_flat_raw", GRAYSCALE_1BPP, 1, false, IMAGE_UNCOMPRESSED, false);
+    EXPECT_EQ(draw("mono1_flat_rle", GRAYSCALE_1BPP, 1, false, IMAGE_COMPRESSED_RLE, false), raw);
+}
+
+TEST_F(BenchPainter, Palette4bpp) {
+    auto raw = draw("pal4_raw", PALETTE_4BPP, 4, true, IMAGE_UNCOMPRESSED, true);
+    EXPECT_EQ(draw("pal4_rle", PALETTE_4BPP, 4, true, IMAGE_COMPRESSED_RLE, true), raw);
+    raw = draw("pal4_flat_raw", PALETTE_4BPP, 4, true, IMAGE_UNCOMPRESSED, false);
+    EXPECT_EQ(draw("pal4_flat_rle", PALETTE_4BPP, 4, true, IMAGE_COMPRESSED_RLE, false), raw);
+}
+
+TEST_F(BenchPainter, Palette8bpp) {
+    auto raw = draw("pal8_raw", PALETTE_8BPP, 8, true, IMAGE_UNCOMPRESSED, true);
+    EXPECT_EQ(draw("pal8_rle", PALETTE_8BPP, 8, true, IMAGE_COMPRESSED_RLE, true), raw);
+    raw = draw("pal8_flat_raw", PALETTE_8BPP, 8, true, IMAGE_UNCOMPRESSED, false);
+    EXPECT_EQ(draw("pal8_flat_rle", PALETTE_8BPP, 8, true, IMAGE_COMPRESSED_RLE, false), raw);
+}
+
+TEST_F(BenchPainter, Native16bpp) {
+    std::vector<uint8_t> pixels = make_pixels(16, true);
+    EXPECT_EQ(draw("rgb565_raw", RGB565_16BPP, 16, false, IMAGE_UNCOMPRESSED, true), pixels);
+    EXPECT_EQ(draw("rgb565_rle", RGB565_16BPP, 16, false, IMAGE_COMPRESSED_RLE, true), pixels);
+    pixels = make_pixels(16, false);
+    EXPECT_EQ(draw("rgb565_flat_raw", RGB565_16BPP, 16, false, IMAGE_UNCOMPRESSED, false), pixels);
+    EXPECT_EQ(draw("rgb565_flat_rle", RGB565_16BPP, 16, false, IMAGE_COMPRESSED_RLE, false), pixels);
+}
+
+TEST_F(BenchPainter, Animation) {
+    std::vector<std::vector<uint8_t>> frames = make_indicator_frames(8);
+    animate("anim_delta_bbox", frames, false);
+    animate("anim_delta_rects", frames, true);
+}
+
+TEST_F(BenchPainter, Text) {
+    constexpr uint8_t                 line_height = 14;
+    std::vector<std::vector<uint8_t>> glyphs;
+    std::vector<uint8_t>              widths;
+    std::vector<uint8_t>              qff  = make_qff(line_height, glyphs, widths);
+    painter_font_handle_t             font = qp_load_font_mem(qff.data());
+    ASSERT_NE(font, nullptr) << "font failed to load";
+
+    // What a status screen redraws every refresh
+    const char *lines[] = {"Layer: BASE", "WPM: 123", "12:34:56", "Caps Word"};
+
+    qp_reset_glyph_cache_stats();
+    uint64_t glyph_count = 0;
+    auto     start       = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds * 10; r++) {
+        for (int l = 0; l < 4; l++) {
+            EXPECT_GT(qp_drawtext(surface, 0, l * line_height, font, lines[l]), 0);
+            glyph_count += strlen(lines[l]);
+        }
+    }
+    auto                   end = std::chrono::steady_clock::now();
+    qp_glyph_cache_stats_t stats;
+    qp_get_glyph_cache_stats(&stats);
+
+    double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    RecordProperty("text_ns_per_glyph", std::to_string(elapsed / glyph_count));
+    printf("[ BENCH    ] %-24s %8llu glyphs %12.0f glyphs/s %9.2f ns/glyph  cache %lu hits %lu misses\n", "text_status", (unsigned long long)glyph_count, glyph_count * 1e9 / elapsed, elapsed / glyph_count, (unsigned long)stats.hits, (unsigned long)stats.misses);
+
+    // White on black, so each set bit of the glyph is a 0xFFFF pixel
+    const uint16_t *pixels = (const uint16_t *)buffer;
+    for (int l = 0; l < 4; l++) {
+        uint16_t x = 0;
+        for (const char *c = lines[l]; *c; c++) {
+            const auto &glyph = glyphs[*c - 0x20];
+            uint8_t     glyph_width = widths[*c - 0x20];
+            for (uint16_t p = 0; p < glyph_width * line_height; p++) {
+                uint16_t expected = (glyph[p / 8] >> (p % 8)) & 1 ? 0xFFFF : 0x0000;
+                ASSERT_EQ(pixels[(l * line_height + p / glyph_width) * width + x + p % glyph_width], expected) << "mismatch in '" << *c << "' of line " << l;
+            }
+            x += glyph_width;
+        }
+    }
+
+    EXPECT_TRUE(qp_close_font(font));
+}
+
+TEST_F(BenchPainter, SurfaceDirtyRects) {
+    // WPM counter in the top-left corner, layer indicator in the bottom-right
+    hud("hud_corners", [](int r) {
+        qp_rect(surface, 4, 4, 43, 17, r * 8, 255, 255, true);
+        qp_rect(surface, 200, 62, 235, 75, r * 8 + 128, 255, 255, true);
+    });
+
+    // Progress bar growing across the middle, clock digit ticking in the top-right
+    hud("hud_progress_clock", [](int r) {
+        qp_rect(surface, 4, 40, 4 + r % (width - 8), 47, 85, 255, 255, true);
+        qp_rect(surface, 220, 4, 229, 17, r * 8, 255, r % 2 ? 255 : 128, true);
+    });
+
+    // Every corner at once, more regions than are tracked by default
+    hud("hud_five_areas", [](int r) {
+        qp_rect(surface, 0, 0, 9, 9, r * 8, 255, 255, true);
+        qp_rect(surface, width - 10, 0, width - 1, 9, r * 8 + 32, 255, 255, true);
+        qp_rect(surface, 0, height - 10, 9, height - 1, r * 8 + 64, 255, 255, true);
+        qp_rect(surface, width - 10, height - 10, width - 1, height - 1, r * 8 + 96, 255, 255, true);
+        qp_rect(surface, width / 2 - 5, height / 2 - 5, width / 2 + 4, height / 2 + 4, r * 8 + 128, 255, 255, true);
+    });
+}
@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QUANTUM_PAINTER_SUPPORTS_256_PALETTE 1
+#define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS 1
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
@@ -0,0 +1,38 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include "test_common.hpp"
+
+class BenchTapDance : public BenchFixture {};
+
+TEST_F(BenchTapDance, typing) {
+    map_alpha_keys();
+    add_key(KeymapKey(0, 0, 3, TD(0)));
+    add_key(KeymapKey(0, 1, 3, TD(1)));
+
+    BenchStream stream;
+    type(stream, "the quick brown fox jumps over the lazy dog ");
+
+    run_stream("tap_dance_typing", stream, 200);
+}
+
+TEST_F(BenchTapDance, dances) {
+    map_alpha_keys();
+    KeymapKey esc_caps(0, 0, 3, TD(0));
+    KeymapKey scln_quot(0, 1, 3, TD(1));
+    add_key(esc_caps);
+    add_key(scln_quot);
+
+    // Single and double taps, each resolved by the tapping term or by the next key.
+    BenchStream stream;
+    stream.tap(esc_caps, 20, TAPPING_TERM + 10);
+    stream.tap(esc_caps, 20, 30).tap(esc_caps, 20, TAPPING_TERM + 10);
+    type(stream, "word");
+    stream.tap(scln_quot, 20, 30);
+    type(stream, "word");
+    stream.tap(scln_quot, 20, 30).tap(scln_quot, 20, 30);
+    type(stream, " ");
+
+    run_stream("tap_dance_dances", stream, 200);
+}
@@ -0,0 +1,13 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum tap_dances { TD_ESC_CAPS, TD_SCLN_QUOT };
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    [TD_ESC_CAPS]  = ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+    [TD_SCLN_QUOT] = ACTION_TAP_DANCE_DOUBLE(KC_SCLN, KC_QUOT)
+};
+// clang-format on
@@ -0,0 +1,85 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+}
+
+class HsvToRgb : public ::testing::Test {
+   protected:
+    // All 256 hues for a given saturation and value
+    void fill(uint8_t s, uint8_t v) {
+        for (int h = 0; h < 256; h++) {
+            hsv[h] = {(uint8_t)h, s, v};
+        }
+    }
+
+    hsv_t hsv[256];
+    rgb_t rgb[256];
+};
+
+static ::testing::AssertionResult same_rgb(hsv_t hsv, rgb_t expected, rgb_t actual) {
+    if (expected.r == actual.r && expected.g == actual.g && expected.b == actual.b) {
+        return ::testing::AssertionSuccess();
+    }
+    return ::testing::AssertionFailure() << "hsv " << (int)hsv.h << "," << (int)hsv.s << "," << (int)hsv.v << ": expected " << (int)expected.r << "," << (int)expected.g << "," << (int)expected.b << " got " << (int)actual.r << "," << (int)actual.g << "," << (int)actual.b;
+}
+
+TEST_F(HsvToRgb, BatchMatchesScalar) {
+    for (int s = 0; s < 256; s++) {
+        for (int v = 0; v < 256; v++) {
+            fill(s, v);
+            hsv_to_rgb_batch(hsv, rgb, 255);
+            hsv_to_rgb_batch(&hsv[255], &rgb[255], 1);
+            for (int h = 0; h < 256; h++) {
+                ASSERT_TRUE(same_rgb(hsv[h], hsv_to_rgb(hsv[h]), rgb[h]));
+            }
+        }
+    }
+}
+
+TEST_F(HsvToRgb, BatchNoCieMatchesScalar) {
+    for (int s = 0; s < 256; s++) {
+        for (int v = 0; v < 256; v++) {
+            fill(s, v);
+            hsv_to_rgb_batch_nocie(hsv, rgb, 255);
+            hsv_to_rgb_batch_nocie(&hsv[255], &rgb[255], 1);
+            for (int h = 0; h < 256; h++) {
+                ASSERT_TRUE(same_rgb(hsv[h], hsv_to_rgb_nocie(hsv[h]), rgb[h]));
+            }
+        }
+    }
+}
+
+TEST_F(HsvToRgb, CieCurveIsApplied) {
+    hsv_t white = {0, 0, 128};
+    hsv_to_rgb_batch(&white, rgb, 1);
+    hsv_to_rgb_batch_nocie(&white, &rgb[1], 1);
+    EXPECT_EQ(rgb[1].r, 128);
+    EXPECT_NE(rgb[0].r, rgb[1].r);
+}
+
+TEST_F(HsvToRgb, EmptyBatchWritesNothing) {
+    fill(255, 255);
+    memset(rgb, 0xAA, sizeof(rgb));
+    hsv_to_rgb_batch(hsv, rgb, 0);
+    EXPECT_EQ(rgb[0].r, 0xAA);
+    EXPECT_EQ(rgb[0].g, 0xAA);
+    EXPECT_EQ(rgb[0].b, 0xAA);
+}
@@ -0,0 +1,225 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_combo.h"
+#include "host.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+/* Runtime generated combos, served instead of key_combos while non-empty. */
+static std::vector<std::vector<uint16_t>> generated_keys;
+static std::vector<combo_t>               generated_combos;
+
+extern "C" uint16_t combo_count(void) {
+    return generated_combos.empty() ? combo_count_raw() : generated_combos.size();
+}
+
+extern "C" combo_t *combo_get(uint16_t combo_idx) {
+    return generated_combos.empty() ? combo_get_raw(combo_idx) : &generated_combos[combo_idx];
+}
+
+static const uint16_t key_pool[] = {
+    KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O,   KC_P,   KC_Q,    KC_R,   KC_S,
+    KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0, KC_ENT, KC_BSPC, KC_TAB,
+};
+#define KEY_POOL_SIZE (sizeof(key_pool) / sizeof(key_pool[0]))
+
+class ComboKeycodeIndex : public TestFixture {
+   protected:
+    ~ComboKeycodeIndex() {
+        use_generated_combos(0);
+    }
+
+    /* Replaces the combo table with `count` two key combos built from distinct pool key pairs. */
+    void use_generated_combos(size_t count) {
+        generated_keys.clear();
+        generated_combos.clear();
+        for (size_t first = 0; first < KEY_POOL_SIZE && generated_keys.size() < count; first++) {
+            for (size_t second = first + 1; second < KEY_POOL_SIZE && generated_keys.size() < count; second++) {
+                generated_keys.push_back({key_pool[first], key_pool[second], COMBO_END});
+            }
+        }
+        for (auto &keys : generated_keys) {
+            generated_combos.push_back(COMBO(keys.data(), KC_F1));
+        }
+        combo_keycode_index_rebuild();
+    }
+
+    std::vector<KeymapKey> map_key_pool() {
+        std::vector<KeymapKey> keys;
+        for (uint8_t i = 0; i < KEY_POOL_SIZE; i++) {
+            keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, key_pool[i]));
+            add_key(keys.back());
+        }
+        return keys;
+    }
+};
+
+TEST_F(ComboKeycodeIndex, combo_tapped) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, longer_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b}, COMBO_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, non_combo_key_passes_through) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_z(0, 1, 0, KC_Z);
+    set_keymap({key_a, key_z});
+
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_z);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Combo key on its own is released once the chord can no longer complete. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeycodeIndex, generated_combos_fire) {
+    TestDriver driver;
+    auto       keys = map_key_pool();
+    use_generated_combos(100);
+
+    /* The 100th combo pairs the third pool key with the 28th. */
+    ASSERT_EQ(generated_keys.back()[0], keys[2].code);
+    ASSERT_EQ(generated_keys.back()[1], keys[27].code);
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({keys[2], keys[27]});
+    VERIFY_AND_CLEAR(driver);
+
+    /* The pair after it is not a combo. */
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_F1)).Times(0);
+    tap_combo({keys[2], keys[28]});
+    VERIFY_AND_CLEAR(driver);
+}
+
+/* Keyboard reports sent while benchmarking, recorded without the overhead of mock expectations. */
+static std::vector<report_keyboard_t> recorded_reports;
+
+static uint8_t recording_keyboard_leds(void) {
+    return 0;
+}
+
+static void recording_send_keyboard(report_keyboard_t *report) {
+    recorded_reports.push_back(*report);
+}
+
+static void recording_send_nkro(report_nkro_t *report) {}
+
+static void recording_send_mouse(report_mouse_t *report) {}
+
+static void recording_send_extra(report_extra_t *report) {}
+
+static host_driver_t recording_driver = {recording_keyboard_leds, recording_send_keyboard, recording_send_nkro, recording_send_mouse, recording_send_extra};
+
+TEST_F(ComboKeycodeIndex, benchmark) {
+    auto keys = map_key_pool();
+
+    host_set_driver(&recording_driver);
+    for (size_t combo_count : {10, 150, 500}) {
+        double                         elapsed[2];
+        std::vector<report_keyboard_t> reports[2];
+        unsigned                       chords = 0;
+
+        for (int indexed = 0; indexed < 2; indexed++) {
+            use_generated_combos(combo_count);
+            if (!indexed) {
+                combo_keycode_index_disable();
+            }
+            recorded_reports.clear();
+
+            /* Mostly single taps, with every fourth event a chord of one of the combos. */
+            const unsigned taps  = 2000;
+            auto           start = std::chrono::steady_clock::now();
+            for (unsigned i = 0; i < taps; i++) {
+                std::vector<KeymapKey *> pressed;
+                if (i % 4 == 3) {
+                    const auto &combo = generated_keys[(i * 13) % combo_count];
+                    for (auto &key : keys) {
+                        if (key.code == combo[0] || key.code == combo[1]) {
+                            pressed.push_back(&key);
+                        }
+                    }
+                } else {
+                    pressed.push_back(&keys[(i * 7) % KEY_POOL_SIZE]);
+                }
+                for (auto key : pressed) {
+                    key->press();
+                }
+                run_one_scan_loop();
+                for (auto key : pressed) {
+                    key->release();
+                }
+                run_one_scan_loop();
+            }
+            elapsed[indexed] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / (taps * 2.0);
+            reports[indexed] = recorded_reports;
+            chords           = taps / 4;
+        }
+
+        printf("%4zu combos: %8.0f ns per key event linear, %8.0f ns indexed\n", combo_count, elapsed[0], elapsed[1]);
+
+        /* Both paths must produce exactly the same reports, with every chord firing its combo. */
+        ASSERT_EQ(reports[0].size(), reports[1].size()) << combo_count << " combos";
+        for (size_t i = 0; i < reports[0].size(); i++) {
+            ASSERT_EQ(memcmp(&reports[0][i], &reports[1][i], sizeof(report_keyboard_t)), 0) << combo_count << " combos, report " << i;
+        }
+        unsigned fired = 0;
+        for (const auto &report : reports[1]) {
+            fired += report.keys[0] == KC_F1 ? 1 : 0;
+        }
+        EXPECT_EQ(fired, chords) << combo_count << " combos";
+
+        /* The linear scan visits every combo on every event, the index only the few containing the key. */
+        if (combo_count == 500) {
+            EXPECT_LT(elapsed[1], elapsed[0]);
+        }
+    }
+    host_set_driver(NULL);
+}
@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { modtest, ab_esc, abc_tab };
+
+uint16_t const modtest_combo[] = {KC_Y, KC_U, COMBO_END};
+uint16_t const ab_combo[]      = {KC_A, KC_B, COMBO_END};
+uint16_t const abc_combo[]     = {KC_A, KC_B, KC_C, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [modtest] = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
+    [ab_esc]  = COMBO(ab_combo, KC_ESC),
+    [abc_tab] = COMBO(abc_combo, KC_TAB),
+};
+// clang-format on
@@ -0,0 +1,298 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+struct Execution {
+    int      id;
+    uint32_t trigger_time;
+    uint32_t now;
+};
+
+static std::vector<Execution> executions;
+
+struct CallbackArg {
+    int      id;
+    uint32_t repeat = 0;
+};
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    auto arg = static_cast<CallbackArg *>(cb_arg);
+    executions.push_back({arg->id, trigger_time, timer_read32()});
+    return arg->repeat;
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        executions.clear();
+        // Drain anything left over by a previous test
+        for (auto token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        tokens.clear();
+    }
+
+    void TearDown() override {
+        for (auto token : tokens) {
+            cancel_deferred_exec(token);
+        }
+    }
+
+    deferred_token defer(uint32_t delay_ms, CallbackArg *arg) {
+        deferred_token token = defer_exec(delay_ms, record_callback, arg);
+        if (token != INVALID_DEFERRED_TOKEN) {
+            tokens.push_back(token);
+        }
+        return token;
+    }
+
+    // Runs the task once per millisecond
+    static void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+
+    static uint32_t next_delay() {
+        uint32_t trigger_time = 0;
+        EXPECT_TRUE(deferred_exec_next_deadline(&trigger_time));
+        return trigger_time - timer_read32();
+    }
+
+    std::vector<deferred_token> tokens;
+};
+
+TEST_F(DeferredExec, ExecutesAtTriggerTime) {
+    CallbackArg args[] = {{0}, {1}, {2}, {3}};
+    uint32_t    start  = timer_read32();
+    defer(30, &args[0]);
+    defer(10, &args[1]);
+    defer(20, &args[2]);
+    defer(10, &args[3]);
+
+    run_for(40);
+    ASSERT_EQ(executions.size(), 4);
+    std::multiset<int> first{executions[0].id, executions[1].id};
+    EXPECT_EQ(first, (std::multiset<int>{1, 3}));
+    EXPECT_EQ(executions[2].id, 2);
+    EXPECT_EQ(executions[3].id, 0);
+    for (auto &execution : executions) {
+        EXPECT_EQ(execution.now, execution.trigger_time) << "Callback " << execution.id << " should run as soon as it is due";
+    }
+    EXPECT_EQ(executions[3].trigger_time, start + 30);
+}
+
+TEST_F(DeferredExec, NextDeadlineTracksEarliest) {
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_next_deadline(&trigger_time)) << "Nothing should be pending";
+
+    CallbackArg    args[] = {{0}, {1}, {2}};
+    deferred_token a      = defer(300, &args[0]);
+    deferred_token b      = defer(100, &args[1]);
+    deferred_token c      = defer(200, &args[2]);
+    EXPECT_EQ(next_delay(), 100);
+
+    EXPECT_TRUE(cancel_deferred_exec(b));
+    EXPECT_EQ(next_delay(), 200);
+
+    EXPECT_TRUE(extend_deferred_exec(c, 500));
+    EXPECT_EQ(next_delay(), 300);
+
+    EXPECT_TRUE(extend_deferred_exec(a, 50));
+    EXPECT_EQ(next_delay(), 50);
+
+    EXPECT_TRUE(cancel_deferred_exec(a));
+    EXPECT_TRUE(cancel_deferred_exec(c));
+    EXPECT_FALSE(deferred_exec_next_deadline(&trigger_time)) << "Nothing should be pending";
+}
+
+TEST_F(DeferredExec, RepeatKeepsScheduleRelativeToTrigger) {
+    CallbackArg arg{0, 10};
+    uint32_t    start = timer_read32();
+    defer(5, &arg);
+
+    run_for(5);
+    ASSERT_EQ(executions.size(), 1);
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_next_deadline(&trigger_time));
+    EXPECT_EQ(trigger_time, start + 15);
+
+    // Falling behind runs the callback once per pass, with the intended trigger times
+    advance_time(30);
+    deferred_exec_task();
+    ASSERT_EQ(executions.size(), 2);
+    EXPECT_EQ(executions[1].trigger_time, start + 15);
+    run_for(1);
+    ASSERT_EQ(executions.size(), 3);
+    EXPECT_EQ(executions[2].trigger_time, start + 25);
+
+    arg.repeat = 0;
+    run_for(20);
+    EXPECT_EQ(executions.size(), 4);
+    EXPECT_FALSE(deferred_exec_next_deadline(&trigger_time)) << "Returning zero should stop repeating";
+}
+
+TEST_F(DeferredExec, CancelledTokenIsNotReused) {
+    CallbackArg    args[] = {{0}, {1}};
+    deferred_token first  = defer(10, &args[0]);
+    EXPECT_TRUE(cancel_deferred_exec(first));
+    EXPECT_FALSE(cancel_deferred_exec(first)) << "Token should no longer be valid";
+
+    deferred_token second = defer(10, &args[1]);
+    EXPECT_NE(second, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(second, first);
+    EXPECT_FALSE(cancel_deferred_exec(first)) << "Stale token should not cancel the new execution";
+    EXPECT_FALSE(extend_deferred_exec(first, 100)) << "Stale token should not extend the new execution";
+
+    run_for(10);
+    ASSERT_EQ(executions.size(), 1);
+    EXPECT_EQ(executions[0].id, 1);
+}
+
+TEST_F(DeferredExec, TableFull) {
+    CallbackArg args[MAX_DEFERRED_EXECUTORS + 1];
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        args[i].id = i;
+        EXPECT_NE(defer(100 + i, &args[i]), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(1, &args[MAX_DEFERRED_EXECUTORS]), INVALID_DEFERRED_TOKEN) << "Table should be full";
+
+    EXPECT_TRUE(cancel_deferred_exec(tokens[3]));
+    EXPECT_NE(defer(1, &args[MAX_DEFERRED_EXECUTORS]), INVALID_DEFERRED_TOKEN) << "Cancelled entry should be reused";
+    EXPECT_EQ(next_delay(), 1);
+}
+
+static deferred_token other_token;
+
+static uint32_t cancel_other_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    cancel_deferred_exec(other_token);
+    return 0;
+}
+
+TEST_F(DeferredExec, CallbackCancelsOtherDueExecution) {
+    CallbackArg    args[] = {{0}, {1}};
+    deferred_token first  = defer_exec(10, cancel_other_callback, &args[0]);
+    other_token           = defer(10, &args[1]);
+    EXPECT_NE(first, INVALID_DEFERRED_TOKEN);
+
+    // Depending on the order of the entries, the other execution may run first, but never both
+    run_for(10);
+    ASSERT_GE(executions.size(), 1);
+    if (executions[0].id == 0) {
+        EXPECT_EQ(executions.size(), 1);
+    }
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_next_deadline(&trigger_time));
+}
+
+TEST_F(DeferredExec, AdvancedTableMatchesReferenceModel) {
+    // Random operations on a custom table, checked against a brute force model of the pending executions
+    deferred_executor_t table[12]           = {0};
+    uint32_t            last_execution_time = timer_read32();
+
+    struct Pending {
+        uint32_t     trigger_time;
+        CallbackArg *arg;
+    };
+    std::deque<CallbackArg>           args;
+    std::map<deferred_token, Pending> model;
+    std::mt19937                      rng(1234);
+    int                               next_id = 0;
+
+    for (int step = 0; step < 5000; step++) {
+        switch (rng() % 4) {
+            case 0: {
+                uint32_t delay = 1 + rng() % 50;
+                args.push_back({next_id++, rng() % 3 == 0 ? 1 + (uint32_t)(rng() % 20) : 0});
+                deferred_token token = defer_exec_advanced(table, 12, delay, record_callback, &args.back());
+                if (token == INVALID_DEFERRED_TOKEN) {
+                    EXPECT_EQ(model.size(), 12) << "Defer should only fail when the table is full";
+                    break;
+                }
+                ASSERT_EQ(model.count(token), 0) << "Token handed out twice";
+                model[token] = {timer_read32() + delay, &args.back()};
+                break;
+            }
+            case 1:
+                if (!model.empty()) {
+                    auto it = std::next(model.begin(), rng() % model.size());
+                    EXPECT_TRUE(cancel_deferred_exec_advanced(table, 12, it->first));
+                    model.erase(it);
+                }
+                break;
+            case 2:
+                if (!model.empty()) {
+                    auto     it    = std::next(model.begin(), rng() % model.size());
+                    uint32_t delay = 1 + rng() % 50;
+                    EXPECT_TRUE(extend_deferred_exec_advanced(table, 12, it->first, delay));
+                    it->second.trigger_time = timer_read32() + delay;
+                }
+                break;
+            case 3: {
+                advance_time(1 + rng() % 3);
+                executions.clear();
+                deferred_exec_advanced_task(table, 12, &last_execution_time);
+
+                std::multiset<int> expected, actual;
+                for (auto it = model.begin(); it != model.end();) {
+                    if ((int32_t)(it->second.trigger_time - timer_read32()) <= 0) {
+                        expected.insert(it->second.arg->id);
+                        if (it->second.arg->repeat) {
+                            it->second.trigger_time += it->second.arg->repeat;
+                        } else {
+                            it = model.erase(it);
+                            continue;
+                        }
+                    }
+                    ++it;
+                }
+                for (auto &execution : executions) {
+                    actual.insert(execution.id);
+                }
+                ASSERT_EQ(actual, expected) << "Wrong executions at step " << step;
+                break;
+            }
+        }
+
+        uint32_t trigger_time = 0;
+        bool     pending      = deferred_exec_advanced_next_deadline(table, 12, &trigger_time);
+        ASSERT_EQ(pending, !model.empty());
+        if (pending) {
+            uint32_t earliest = model.begin()->second.trigger_time;
+            for (auto &entry : model) {
+                if ((int32_t)(entry.second.trigger_time - earliest) < 0) {
+                    earliest = entry.second.trigger_time;
+                }
+            }
+            ASSERT_EQ(trigger_time, earliest) << "Wrong next deadline at step " << step;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "nvm_dynamic_keymap.h"
+
+void shutdown_quantum(bool jump_to_bootloader);
+}
+
+class DynamicKeymapCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+};
+
+TEST_F(DynamicKeymapCache, WritesAreServedFromRamUntilFlushed) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 1, 2), KC_NO);
+    EXPECT_TRUE(dynamic_keymap_cache_is_dirty());
+
+    idle_for(DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY + 1);
+    EXPECT_FALSE(dynamic_keymap_cache_is_dirty());
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 1, 2), KC_A);
+}
+
+TEST_F(DynamicKeymapCache, FlushWaitsForWritesToSettle) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    idle_for(DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY / 2);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_B);
+    idle_for(DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY / 2 + 1);
+
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_NO);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 1), KC_NO);
+
+    idle_for(DYNAMIC_KEYMAP_CACHE_FLUSH_DELAY);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(DynamicKeymapCache, UncachedLayersAreWrittenThrough) {
+    dynamic_keymap_set_keycode(1, 3, 4, KC_C);
+
+    EXPECT_FALSE(dynamic_keymap_cache_is_dirty());
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(1, 3, 4), KC_C);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 3, 4), KC_C);
+}
+
+TEST_F(DynamicKeymapCache, BufferAccessSpansCachedAndUncachedLayers) {
+    // Last key of layer 0 and first key of layer 1, starting half way through a keycode
+    const uint16_t layer_size = MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t        data[4]    = {0x04, 0x00, 0x05, 0x00};
+    dynamic_keymap_set_buffer(layer_size - 1, sizeof(data), data);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS - 1, MATRIX_COLS - 1), 0x0004);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), 0x0005);
+    // The test keymap only defines layer 0, so the reset leaves layer 1 transparent
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 1), KC_TRNS);
+
+    uint8_t read[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    dynamic_keymap_get_buffer(layer_size - 2, sizeof(read), read);
+    const uint8_t expected[6] = {0x00, 0x04, 0x00, 0x05, 0x00, KC_TRNS};
+    for (uint8_t i = 0; i < sizeof(read); i++) {
+        EXPECT_EQ(read[i], expected[i]) << "at byte " << +i;
+    }
+
+    dynamic_keymap_cache_flush();
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, MATRIX_ROWS - 1, MATRIX_COLS - 1), 0x0004);
+}
+
+TEST_F(DynamicKeymapCache, RleRunSpansCachedAndUncachedLayers) {
+    // A run covering the last two keys of layer 0 and the first three of layer 1, followed by a literal
+    const uint16_t layer_size = MATRIX_ROWS * MATRIX_COLS * 2;
+    uint16_t       offset     = layer_size - 4;
+    uint8_t        data[6]    = {DYNAMIC_KEYMAP_RLE_RUN | 5, 0x00, KC_E, 0x01, 0x00, KC_F};
+    EXPECT_TRUE(dynamic_keymap_set_buffer_rle(&offset, layer_size + 8, data, sizeof(data)));
+    EXPECT_EQ(offset, layer_size + 8);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS - 1, MATRIX_COLS - 2), KC_E);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS - 1, MATRIX_COLS - 1), KC_E);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(1, 0, 0), KC_E);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(1, 0, 2), KC_E);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(1, 0, 3), KC_F);
+
+    // Reading back encodes the same tokens
+    uint8_t read[8] = {0};
+    offset          = layer_size - 4;
+    EXPECT_EQ(dynamic_keymap_get_buffer_rle(&offset, layer_size + 8, read, sizeof(read)), sizeof(data));
+    EXPECT_EQ(offset, layer_size + 8);
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(read[i], data[i]) << "at byte " << +i;
+    }
+}
+
+TEST_F(DynamicKeymapCache, ResetIsStoredImmediately) {
+    dynamic_keymap_set_keycode(0, 2, 2, KC_D);
+    dynamic_keymap_reset();
+
+    EXPECT_FALSE(dynamic_keymap_cache_is_dirty());
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 2, 2), KC_NO);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 2, 2), KC_NO);
+}
+
+TEST_F(DynamicKeymapCache, ShutdownFlushesPendingWrites) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 3, 3, KC_E);
+    shutdown_quantum(false);
+
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 3, 3), KC_E);
+}
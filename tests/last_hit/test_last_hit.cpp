@@ -0,0 +1,134 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "last_hit.h"
+}
+
+#define LED_COUNT 8
+
+class LastHit : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        last_hit_clear(&buffer);
+        snapshot();
+    }
+
+    void snapshot() {
+        last_hit_snapshot(&buffer, &tracker, led_hit, LED_COUNT);
+    }
+
+    // Hits are placed at x = 10 * index, y = index
+    bool push(uint8_t index, uint16_t *dropped_tick = NULL) {
+        return last_hit_push(&buffer, index, 10 * index, index, dropped_tick);
+    }
+
+    last_hit_buffer_t buffer;
+    last_hit_t        tracker;
+    uint8_t           led_hit[LED_COUNT];
+};
+
+TEST_F(LastHit, StartsEmpty) {
+    EXPECT_EQ(tracker.count, 0);
+    for (uint8_t i = 0; i < LED_COUNT; i++) {
+        EXPECT_EQ(led_hit[i], LAST_HIT_NONE);
+    }
+}
+
+TEST_F(LastHit, HitsAreListedOldestFirst) {
+    push(5);
+    last_hit_advance(&buffer, 10);
+    push(2);
+    snapshot();
+
+    ASSERT_EQ(tracker.count, 2);
+    EXPECT_EQ(tracker.index[0], 5);
+    EXPECT_EQ(tracker.x[0], 50);
+    EXPECT_EQ(tracker.y[0], 5);
+    EXPECT_EQ(tracker.tick[0], 10);
+    EXPECT_EQ(tracker.index[1], 2);
+    EXPECT_EQ(tracker.tick[1], 0);
+}
+
+TEST_F(LastHit, FullBufferReplacesOldestHit) {
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; i++) {
+        EXPECT_FALSE(push(i));
+        last_hit_advance(&buffer, 1);
+    }
+
+    // Wrap around the ring twice
+    for (uint8_t i = 0; i < 2 * LED_HITS_TO_REMEMBER; i++) {
+        uint16_t dropped_tick = 0;
+        EXPECT_TRUE(push(LED_HITS_TO_REMEMBER + i % 2, &dropped_tick));
+        EXPECT_EQ(dropped_tick, LED_HITS_TO_REMEMBER);
+        last_hit_advance(&buffer, 1);
+    }
+    snapshot();
+
+    ASSERT_EQ(tracker.count, LED_HITS_TO_REMEMBER);
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; i++) {
+        EXPECT_EQ(tracker.index[i], LED_HITS_TO_REMEMBER + i % 2);
+        EXPECT_EQ(tracker.tick[i], LED_HITS_TO_REMEMBER - i);
+    }
+}
+
+TEST_F(LastHit, ExpiredHitsAreDroppedFromTheOldestEnd) {
+    push(1);
+    last_hit_advance(&buffer, UINT16_MAX - 100);
+    push(2);
+    last_hit_advance(&buffer, 50);
+    push(3);
+
+    EXPECT_EQ(last_hit_advance(&buffer, 100), 1);
+    snapshot();
+    ASSERT_EQ(tracker.count, 2);
+    EXPECT_EQ(tracker.index[0], 2);
+    EXPECT_EQ(tracker.tick[0], 150);
+    EXPECT_EQ(tracker.index[1], 3);
+    EXPECT_EQ(tracker.tick[1], 100);
+    EXPECT_EQ(led_hit[1], LAST_HIT_NONE);
+}
+
+TEST_F(LastHit, LongDelayDropsEverything) {
+    push(1);
+    push(2);
+    EXPECT_EQ(last_hit_advance(&buffer, 100000), 2);
+    snapshot();
+    EXPECT_EQ(tracker.count, 0);
+}
+
+TEST_F(LastHit, LedHitPointsAtMostRecentHit) {
+    push(4);
+    push(6);
+    push(4);
+    snapshot();
+
+    EXPECT_EQ(led_hit[4], 2);
+    EXPECT_EQ(led_hit[6], 1);
+    EXPECT_EQ(led_hit[0], LAST_HIT_NONE);
+}
+
+TEST_F(LastHit, LedHitIgnoresIndicesOutOfRange) {
+    push(LED_COUNT);
+    snapshot();
+
+    EXPECT_EQ(tracker.count, 1);
+    for (uint8_t i = 0; i < LED_COUNT; i++) {
+        EXPECT_EQ(led_hit[i], LAST_HIT_NONE);
+    }
+}
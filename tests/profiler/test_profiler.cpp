@@ -0,0 +1,138 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "profiler.h"
+}
+
+using testing::_;
+
+class Profiler : public TestFixture {
+   protected:
+    void SetUp() override {
+        profiler_reset();
+    }
+
+    const profiler_probe_t *find_probe(const char *name) {
+        for (uint8_t i = 0; i < profiler_probe_count(); i++) {
+            const profiler_probe_t *probe = profiler_get_probe(i);
+            if (strcmp(probe->name, name) == 0) {
+                return probe;
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(Profiler, KeyboardTaskProbesAreRecorded) {
+    TestDriver driver;
+
+    run_one_scan_loop();
+    run_one_scan_loop();
+
+    for (const char *name : {"keyboard_task", "matrix_task", "quantum_task()"}) {
+        const profiler_probe_t *probe = find_probe(name);
+        ASSERT_NE(probe, nullptr) << name;
+        EXPECT_EQ(probe->count, 2) << name;
+        EXPECT_LE(probe->min, probe->max) << name;
+    }
+
+    // The task probes are nested within keyboard_task.
+    EXPECT_GE(find_probe("keyboard_task")->max, find_probe("matrix_task")->min);
+}
+
+TEST_F(Profiler, ReportSendIsRecorded) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    const profiler_probe_t *probe = find_probe("host_keyboard_send");
+    ASSERT_NE(probe, nullptr);
+    EXPECT_EQ(probe->count, 2);
+}
+
+TEST_F(Profiler, StatisticsAreAccumulated) {
+    uint8_t index = profiler_register_probe("stats");
+    ASSERT_NE(index, PROFILER_INVALID_PROBE);
+    EXPECT_EQ(profiler_register_probe("stats"), index);
+
+    profiler_record(index, 10);
+    profiler_record(index, 100);
+    profiler_record(index, 1000);
+
+    const profiler_probe_t *probe = profiler_get_probe(index);
+    EXPECT_EQ(probe->count, 3);
+    EXPECT_EQ(probe->min, 10);
+    EXPECT_EQ(probe->max, 1000);
+    EXPECT_EQ(probe->total, 1110);
+
+    // Bucket 0 holds durations below 16 ticks, then one bucket per power of two.
+    EXPECT_EQ(probe->histogram[0], 1);
+    EXPECT_EQ(probe->histogram[3], 1);
+    EXPECT_EQ(probe->histogram[6], 1);
+}
+
+TEST_F(Profiler, LongDurationsSaturateLastBucket) {
+    uint8_t index = profiler_register_probe("long");
+
+    profiler_record(index, UINT32_MAX);
+    profiler_record(index, 1UL << 20);
+
+    EXPECT_EQ(profiler_get_probe(index)->histogram[PROFILER_HISTOGRAM_BUCKETS - 1], 2);
+}
+
+TEST_F(Profiler, ResetKeepsRegistration) {
+    uint8_t index = profiler_register_probe("reset");
+    profiler_record(index, 42);
+
+    profiler_reset();
+
+    const profiler_probe_t *probe = profiler_get_probe(index);
+    EXPECT_STREQ(probe->name, "reset");
+    EXPECT_EQ(probe->count, 0);
+    EXPECT_EQ(probe->max, 0);
+    EXPECT_EQ(probe->histogram[2], 0);
+    EXPECT_EQ(profiler_register_probe("reset"), index);
+}
+
+TEST_F(Profiler, ProbeTableOverflowIsIgnored) {
+    static char names[PROFILER_MAX_PROBES + 1][8];
+    uint8_t     index = 0;
+    for (uint8_t i = 0; i <= PROFILER_MAX_PROBES; i++) {
+        snprintf(names[i], sizeof(names[i]), "fill%u", i);
+        index = profiler_register_probe(names[i]);
+    }
+
+    EXPECT_EQ(index, PROFILER_INVALID_PROBE);
+    EXPECT_EQ(profiler_probe_count(), PROFILER_MAX_PROBES);
+
+    // Recording against an invalid probe is a no-op.
+    profiler_record(PROFILER_INVALID_PROBE, 1);
+}
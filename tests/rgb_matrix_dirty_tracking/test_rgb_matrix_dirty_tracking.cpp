@@ -0,0 +1,112 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        { 0, 1, NO_LED, NO_LED },
+        { 2, 3, NO_LED, NO_LED },
+    },
+    { { 0, 0 }, { 224, 0 }, { 0, 64 }, { 224, 64 } },
+    { 4, 4, 4, 4 }
+};
+// clang-format on
+
+static uint8_t set_color_calls[RGB_MATRIX_LED_COUNT];
+static uint8_t flush_calls;
+static int     indicator_led = -1;
+
+static void counting_init(void) {}
+
+static void counting_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    set_color_calls[index]++;
+}
+
+static void counting_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        counting_set_color(i, red, green, blue);
+    }
+}
+
+static void counting_flush(void) {
+    flush_calls++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = counting_init,
+    .set_color     = counting_set_color,
+    .set_color_all = counting_set_color_all,
+    .flush         = counting_flush,
+};
+
+bool rgb_matrix_indicators_user(void) {
+    if (indicator_led >= 0) {
+        rgb_matrix_set_color(indicator_led, 0, 0, 255);
+    }
+    return true;
+}
+}
+
+class RgbMatrixDirtyTracking : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        indicator_led = -1;
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        // Let the first frame after the mode change go out in full
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+        reset_counts();
+    }
+
+    void reset_counts() {
+        memset(set_color_calls, 0, sizeof(set_color_calls));
+        flush_calls = 0;
+    }
+
+    // Runs the scan loop long enough for a few frames to be rendered
+    void render_frames() {
+        idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 4);
+    }
+};
+
+TEST_F(RgbMatrixDirtyTracking, UnchangedFrameSkipsTheFlush) {
+    render_frames();
+    EXPECT_EQ(flush_calls, 0);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(set_color_calls[i], 0) << "LED " << (int)i;
+    }
+}
+
+TEST_F(RgbMatrixDirtyTracking, SingleChangedLedMarksTheFrameDirty) {
+    indicator_led = 2;
+    render_frames();
+    // Only the frame that painted the indicator differs from the driver state
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(set_color_calls[0], 0);
+    EXPECT_EQ(set_color_calls[1], 0);
+    EXPECT_EQ(set_color_calls[2], 1);
+    EXPECT_EQ(set_color_calls[3], 0);
+
+    // Once the indicator is gone, the LED is restored from the effect
+    indicator_led = -1;
+    reset_counts();
+    render_frames();
+    EXPECT_EQ(flush_calls, 1);
+    EXPECT_EQ(set_color_calls[2], 1);
+}
+
+TEST_F(RgbMatrixDirtyTracking, ConfigChangeFlushesEveryLed) {
+    rgb_matrix_sethsv_noeeprom(85, 255, 255);
+    render_frames();
+    EXPECT_EQ(flush_calls, 1);
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        EXPECT_EQ(set_color_calls[i], 1) << "LED " << (int)i;
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+// clang-format off
+led_config_t g_led_config = {
+    {
+        { 0, 1, 2, 3 },
+        { 4, 5, 6, 7 },
+        { 8, 9, 10, 11 },
+    },
+    {
+        { 0, 0 }, { 75, 0 }, { 150, 0 }, { 224, 0 },
+        { 0, 32 }, { 75, 32 }, { 150, 32 }, { 224, 32 },
+        { 0, 64 }, { 75, 64 }, { 150, 64 }, { 224, 64 },
+    },
+    { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 }
+};
+// clang-format on
+
+static rgb_t sent[RGB_MATRIX_LED_COUNT];
+
+static void recording_init(void) {}
+
+static void recording_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    sent[index] = (rgb_t){.r = red, .g = green, .b = blue};
+}
+
+static void recording_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        recording_set_color(i, red, green, blue);
+    }
+}
+
+static void recording_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = recording_init,
+    .set_color     = recording_set_color,
+    .set_color_all = recording_set_color_all,
+    .flush         = recording_flush,
+};
+
+// Halves the brightness, like keyboards limiting their current draw do
+rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
+    hsv.v /= 2;
+    return hsv_to_rgb(hsv);
+}
+}
+
+class RgbMatrixHsvOverride : public TestFixture {};
+
+TEST_F(RgbMatrixHsvOverride, BatchConversionUsesTheOverride) {
+    rgb_matrix_hsv_batch_t batch = {0};
+
+    // More colors than fit in one batch, so both the full and the final flush are covered
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_hsv_batch_add(&batch, i, (hsv_t){.h = (uint8_t)(i * 20), .s = 255, .v = 255});
+    }
+    rgb_matrix_hsv_batch_flush(&batch);
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_t expected = rgb_matrix_hsv_to_rgb((hsv_t){.h = (uint8_t)(i * 20), .s = 255, .v = 255});
+        EXPECT_EQ(sent[i].r, expected.r) << "LED " << (int)i;
+        EXPECT_EQ(sent[i].g, expected.g) << "LED " << (int)i;
+        EXPECT_EQ(sent[i].b, expected.b) << "LED " << (int)i;
+        EXPECT_LE(MAX(sent[i].r, MAX(sent[i].g, sent[i].b)), 128) << "LED " << (int)i;
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+// Uneven spacing, so that some pairs sit right at the radius and most are outside of it
+// clang-format off
+led_config_t g_led_config = {
+    {
+        { 0, 1, 2, 3 },
+        { 4, 5, 6, 7 },
+        { 8, 9, 10, 11 },
+    },
+    {
+        { 0, 0 }, { 40, 0 }, { 72, 0 }, { 224, 0 },
+        { 0, 24 }, { 24, 32 }, { 112, 32 }, { 200, 40 },
+        { 0, 64 }, { 28, 64 }, { 150, 64 }, { 224, 64 },
+    },
+    { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 }
+};
+// clang-format on
+
+static void noop_init(void) {}
+static void noop_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {}
+static void noop_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {}
+static void noop_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = noop_init,
+    .set_color     = noop_set_color,
+    .set_color_all = noop_set_color_all,
+    .flush         = noop_flush,
+};
+
+typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t *params, reactive_splash_f effect_func);
+
+static uint16_t splash_calls;
+static uint16_t splash_mismatches;
+
+// Checks every distance handed to the effect against the square root it replaces
+static hsv_t checking_splash(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick) {
+    splash_calls++;
+    if (dist != sqrt16(dx * dx + dy * dy)) {
+        splash_mismatches++;
+    }
+    return hsv;
+}
+}
+
+class RgbMatrixNeighbours : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(rgb_matrix_neighbours_init());
+    }
+
+    // What the effects computed before the table existed
+    static uint8_t point_distance(uint8_t a, uint8_t b) {
+        int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+        int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+        return sqrt16(dx * dx + dy * dy);
+    }
+};
+
+TEST_F(RgbMatrixNeighbours, DistancesMatchThePoints) {
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        for (uint8_t b = 0; b < RGB_MATRIX_LED_COUNT; b++) {
+            EXPECT_EQ(rgb_matrix_led_distance(a, b), point_distance(a, b)) << "LEDs " << (int)a << " and " << (int)b;
+        }
+    }
+}
+
+TEST_F(RgbMatrixNeighbours, ListsHoldEveryLedWithinTheRadius) {
+    EXPECT_TRUE(rgb_matrix_neighbours_valid());
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        uint8_t                       count;
+        const rgb_matrix_neighbour_t *neighbours = rgb_matrix_neighbours(a, &count);
+
+        uint8_t n = 0;
+        for (uint8_t b = 0; b < RGB_MATRIX_LED_COUNT; b++) {
+            if (b == a || point_distance(a, b) > RGB_MATRIX_NEIGHBOUR_RADIUS) continue;
+            ASSERT_LT(n, count) << "LED " << (int)a << " is missing " << (int)b;
+            EXPECT_EQ(neighbours[n].index, b) << "LED " << (int)a;
+            EXPECT_EQ(neighbours[n].distance, point_distance(a, b)) << "LED " << (int)a;
+            n++;
+        }
+        EXPECT_EQ(n, count) << "LED " << (int)a;
+    }
+}
+
+TEST_F(RgbMatrixNeighbours, LayoutHasPairsOnBothSidesOfTheRadius) {
+    uint16_t inside = 0, outside = 0;
+    for (uint8_t a = 0; a < RGB_MATRIX_LED_COUNT; a++) {
+        uint8_t count;
+        rgb_matrix_neighbours(a, &count);
+        inside += count;
+        outside += RGB_MATRIX_LED_COUNT - 1 - count;
+    }
+    EXPECT_GT(inside, 0);
+    EXPECT_GT(outside, inside);
+}
+
+TEST_F(RgbMatrixNeighbours, SplashRunnerDistancesMatchThePoints) {
+    const uint8_t hits[] = {5, 0, 11, 5};
+
+    g_last_hit_tracker.count = sizeof(hits);
+    for (uint8_t j = 0; j < sizeof(hits); j++) {
+        g_last_hit_tracker.x[j]     = g_led_config.point[hits[j]].x;
+        g_last_hit_tracker.y[j]     = g_led_config.point[hits[j]].y;
+        g_last_hit_tracker.index[j] = hits[j];
+        g_last_hit_tracker.tick[j]  = 0;
+    }
+
+    splash_calls      = 0;
+    splash_mismatches = 0;
+    effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = false};
+    while (effect_runner_reactive_splash(0, &params, &checking_splash)) {
+        params.iter++;
+    }
+    EXPECT_EQ(splash_calls, RGB_MATRIX_LED_COUNT * sizeof(hits));
+    EXPECT_EQ(splash_mismatches, 0);
+    g_last_hit_tracker.count = 0;
+}
@@ -0,0 +1,47 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Counts heap allocations made while a benchmark is running. Firmware code is not expected to
+ * allocate at all, so any count here points at a regression in a process_* handler. */
+
+bool     bench_allocation_counting = false;
+uint64_t bench_allocations         = 0;
+
+#if defined(__GLIBC__)
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+bool bench_allocations_supported(void) {
+    return true;
+}
+
+void *malloc(size_t size) {
+    if (bench_allocation_counting) {
+        bench_allocations++;
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (bench_allocation_counting) {
+        bench_allocations++;
+    }
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (bench_allocation_counting) {
+        bench_allocations++;
+    }
+    return __libc_realloc(ptr, size);
+}
+#else
+bool bench_allocations_supported(void) {
+    return false;
+}
+#endif
@@ -0,0 +1,178 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "test_matrix.h"
+
+extern "C" {
+#include "host.h"
+#include "profiler.h"
+
+void advance_time(uint32_t ms);
+
+extern bool     bench_allocation_counting;
+extern uint64_t bench_allocations;
+bool            bench_allocations_supported(void);
+}
+
+static uint8_t bench_keyboard_leds(void) {
+    return 0;
+}
+
+static void bench_send_keyboard(report_keyboard_t *report) {}
+static void bench_send_nkro(report_nkro_t *report) {}
+static void bench_send_mouse(report_mouse_t *report) {}
+static void bench_send_extra(report_extra_t *report) {}
+
+static host_driver_t bench_driver = {bench_keyboard_leds, bench_send_keyboard, bench_send_nkro, bench_send_mouse, bench_send_extra};
+
+BenchStream &BenchStream::press(const KeymapKey &key, unsigned idle_ms) {
+    steps.push_back({key.position, true, true, idle_ms});
+    return *this;
+}
+
+BenchStream &BenchStream::release(const KeymapKey &key, unsigned idle_ms) {
+    steps.push_back({key.position, true, false, idle_ms});
+    return *this;
+}
+
+BenchStream &BenchStream::tap(const KeymapKey &key, unsigned hold_ms, unsigned idle_ms) {
+    return press(key, hold_ms).release(key, idle_ms);
+}
+
+BenchStream &BenchStream::chord(const std::vector<KeymapKey> &keys, unsigned hold_ms, unsigned idle_ms) {
+    for (size_t i = 0; i < keys.size(); i++) {
+        press(keys[i], i + 1 < keys.size() ? 1 : hold_ms);
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        release(keys[i], i + 1 < keys.size() ? 1 : idle_ms);
+    }
+    return *this;
+}
+
+BenchStream &BenchStream::idle(unsigned ms) {
+    steps.push_back({{0, 0}, false, false, ms});
+    return *this;
+}
+
+uint64_t BenchStream::events() const {
+    uint64_t events = 0;
+    for (const auto &step : steps) {
+        events += step.has_key;
+    }
+    return events;
+}
+
+double BenchResult::events_per_second() const {
+    return elapsed_ns ? events * 1e9 / elapsed_ns : 0;
+}
+
+double BenchResult::ns_per_event() const {
+    return events ? (double)elapsed_ns / events : 0;
+}
+
+double BenchResult::ns_per_action_exec() const {
+    return action_exec_calls ? (double)action_exec_ns / action_exec_calls : 0;
+}
+
+BenchFixture::BenchFixture() {
+    host_set_driver(&bench_driver);
+}
+
+void BenchFixture::scan(unsigned ms) {
+    for (unsigned i = 0; i < ms; i++) {
+        keyboard_task();
+        housekeeping_task();
+        advance_time(1);
+    }
+}
+
+BenchResult BenchFixture::run_stream(const std::string &name, const BenchStream &stream, unsigned iterations) {
+    auto replay = [&]() {
+        for (const auto &step : stream.steps) {
+            if (step.has_key) {
+                if (step.pressed) {
+                    press_key(step.position.col, step.position.row);
+                } else {
+                    release_key(step.position.col, step.position.row);
+                }
+            }
+            scan(step.idle_ms);
+        }
+    };
+
+    uint64_t scans_per_iteration = 0;
+    for (const auto &step : stream.steps) {
+        scans_per_iteration += step.idle_ms;
+    }
+
+    replay();
+    profiler_reset();
+
+    bench_allocations         = 0;
+    bench_allocation_counting = true;
+    auto start                = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        replay();
+    }
+    auto end                  = std::chrono::steady_clock::now();
+    bench_allocation_counting = false;
+
+    BenchResult result = {};
+    result.name        = name;
+    result.iterations  = iterations;
+    result.events      = stream.events() * iterations;
+    result.scans       = scans_per_iteration * iterations;
+    result.elapsed_ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.allocations = bench_allocations_supported() ? (int64_t)bench_allocations : -1;
+
+    for (uint8_t i = 0; i < profiler_probe_count(); i++) {
+        const profiler_probe_t *probe = profiler_get_probe(i);
+        if (strcmp(probe->name, "action_exec") == 0) {
+            result.action_exec_calls = probe->count;
+            result.action_exec_ns    = (uint64_t)((double)probe->total * 1e9 / profiler_counter_frequency());
+        }
+    }
+
+    RecordProperty(name + "_events_per_second", std::to_string((uint64_t)result.events_per_second()));
+    RecordProperty(name + "_ns_per_event", std::to_string((uint64_t)result.ns_per_event()));
+    RecordProperty(name + "_ns_per_action_exec", std::to_string((uint64_t)result.ns_per_action_exec()));
+    RecordProperty(name + "_allocations", std::to_string(result.allocations));
+
+    // Firmware code must not allocate, the harness itself does not allocate while replaying.
+    EXPECT_LE(result.allocations, 0) << name << " allocated on the heap";
+
+    print_result(result);
+    return result;
+}
+
+void BenchFixture::map_alpha_keys() {
+    for (uint8_t i = 0; i <= 26; i++) {
+        alpha_keys.push_back(KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, i < 26 ? KC_A + i : KC_SPACE));
+        add_key(alpha_keys.back());
+    }
+}
+
+void BenchFixture::type(BenchStream &stream, const char *text, unsigned hold_ms, unsigned gap_ms) const {
+    for (const char *c = text; *c; c++) {
+        if (*c >= 'a' && *c <= 'z') {
+            stream.tap(alpha_keys[*c - 'a'], hold_ms, gap_ms);
+        } else if (*c == ' ') {
+            stream.tap(alpha_keys[26], hold_ms, gap_ms);
+        }
+    }
+}
+
+void BenchFixture::print_result(const BenchResult &result) {
+    char allocations[24];
+    if (result.allocations < 0) {
+        snprintf(allocations, sizeof(allocations), "n/a");
+    } else {
+        snprintf(allocations, sizeof(allocations), "%.3f", (double)result.allocations / (result.events ? result.events : 1));
+    }
+
+    printf("[ BENCH    ] %-24s %10llu events %12.0f events/s %9.1f ns/event %9.1f ns/action_exec %8s allocs/event\n", result.name.c_str(), (unsigned long long)result.events, result.events_per_second(), result.ns_per_event(), result.ns_per_action_exec(), allocations);
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief A scripted sequence of key presses and releases, replayed by BenchFixture.
+ *
+ * Each step changes at most one key and is followed by `idle_ms` scan loops. A stream
+ * has to release every key it presses, so that it can be replayed back to back.
+ */
+class BenchStream {
+   public:
+    struct Step {
+        keypos_t position;
+        bool     has_key;
+        bool     pressed;
+        unsigned idle_ms;
+    };
+
+    BenchStream& press(const KeymapKey& key, unsigned idle_ms = 1);
+    BenchStream& release(const KeymapKey& key, unsigned idle_ms = 1);
+
+    /**
+     * @brief Presses `key`, holds it for `hold_ms` and idles for `idle_ms` after the release.
+     */
+    BenchStream& tap(const KeymapKey& key, unsigned hold_ms = 1, unsigned idle_ms = 1);
+
+    /**
+     * @brief Presses all `keys` one scan apart, holds them for `hold_ms` and releases them in order.
+     */
+    BenchStream& chord(const std::vector<KeymapKey>& keys, unsigned hold_ms = 1, unsigned idle_ms = 1);
+
+    BenchStream& idle(unsigned ms);
+
+    /**
+     * @brief Number of key events, i.e. presses and releases, in the stream.
+     */
+    uint64_t events() const;
+
+    std::vector<Step> steps;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t    iterations;
+    uint64_t    events;
+    uint64_t    scans;
+    uint64_t    elapsed_ns;
+    uint64_t    action_exec_calls;
+    uint64_t    action_exec_ns;
+    /* Heap allocations made while the stream was running, -1 if they cannot be counted on this host. */
+    int64_t allocations;
+
+    double events_per_second() const;
+    double ns_per_event() const;
+    double ns_per_action_exec() const;
+};
+
+/**
+ * @brief Test fixture that replays key streams through the full keyboard_task() pipeline and
+ * reports their throughput. Reports are sent to a host driver that discards them.
+ */
+class BenchFixture : public TestFixture {
+   public:
+    BenchFixture();
+
+    /**
+     * @brief Replays `stream` once to warm up, then `iterations` times while measuring.
+     */
+    BenchResult run_stream(const std::string& name, const BenchStream& stream, unsigned iterations);
+
+    static void print_result(const BenchResult& result);
+
+    /**
+     * @brief Maps KC_A to KC_Z and KC_SPACE to the first 27 matrix positions of layer 0.
+     *
+     * The remaining positions, row 2 from column 7 and row 3, are free for feature keys.
+     */
+    void map_alpha_keys();
+
+    /**
+     * @brief Appends taps for each lower case letter and space in `text` to `stream`.
+     */
+    void type(BenchStream& stream, const char* text, unsigned hold_ms = 20, unsigned gap_ms = 30) const;
+
+   protected:
+    void scan(unsigned ms);
+
+    std::vector<KeymapKey> alpha_keys;
+};
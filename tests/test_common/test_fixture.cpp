@@ -59,6 +59,9 @@ void TestFixture::TearDownTestCase() {}
 TestFixture::TestFixture() {
     m_this = this;
     timer_clear();
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_invalidate();
+#endif
     keyrecord_t empty_keyrecord = {0};
     test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &empty_keyrecord) << "ms" << std::endl;
 }
@@ -104,6 +107,9 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_invalidate();
+#endif
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
@@ -0,0 +1,149 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "leader.h"
+}
+
+using testing::_;
+
+class Tickless : public TestFixture {
+   protected:
+    // Runs the keyboard task up to, but not including, the given deadline
+    void idle_until(uint32_t deadline) {
+        ASSERT_GE(deadline, timer_read32());
+        idle_for(deadline - timer_read32());
+    }
+};
+
+static uint32_t noop_callback(uint32_t trigger_time, void *cb_arg) {
+    return 0;
+}
+
+TEST_F(Tickless, NothingPendingWhileIdle) {
+    TestDriver driver;
+    uint32_t   deadline;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    EXPECT_FALSE(keyboard_next_deadline(&deadline));
+}
+
+TEST_F(Tickless, TapHoldKeySettlesAtDeadline) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    uint32_t pressed = timer_read32();
+    mod_tap_key.press();
+    run_one_scan_loop();
+
+    uint32_t deadline;
+    EXPECT_TRUE(keyboard_next_deadline(&deadline));
+    EXPECT_EQ(deadline, pressed + TAPPING_TERM);
+
+    idle_until(deadline);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(keyboard_next_deadline(&deadline));
+}
+
+TEST_F(Tickless, TappedKeyIsPendingUntilTappingTerm) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    uint32_t released = timer_read32();
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The tap is remembered for a quick repeat until the tapping term after the release expires
+    uint32_t deadline;
+    EXPECT_TRUE(keyboard_next_deadline(&deadline));
+    EXPECT_EQ(deadline, released + TAPPING_TERM);
+
+    EXPECT_NO_REPORT(driver);
+    idle_until(deadline);
+    run_one_scan_loop();
+    EXPECT_FALSE(keyboard_next_deadline(&deadline));
+}
+
+TEST_F(Tickless, LeaderTimesOutAtDeadline) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    set_keymap({key_leader});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    EXPECT_TRUE(leader_sequence_active());
+
+    uint32_t deadline;
+    EXPECT_TRUE(keyboard_next_deadline(&deadline));
+    idle_until(deadline);
+    EXPECT_TRUE(leader_sequence_active());
+
+    run_one_scan_loop();
+    EXPECT_FALSE(leader_sequence_active());
+    EXPECT_FALSE(keyboard_next_deadline(&deadline));
+}
+
+TEST_F(Tickless, EarliestDeadlineIsReported) {
+    TestDriver driver;
+    auto       key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    set_keymap({key_leader});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+
+    uint32_t leader_deadline;
+    EXPECT_TRUE(leader_next_deadline(&leader_deadline));
+
+    deferred_token token = defer_exec(10, noop_callback, NULL);
+    uint32_t       deadline;
+    EXPECT_TRUE(keyboard_next_deadline(&deadline));
+    EXPECT_EQ(deadline, timer_read32() + 10);
+
+    cancel_deferred_exec(token);
+    EXPECT_TRUE(keyboard_next_deadline(&deadline));
+    EXPECT_EQ(deadline, leader_deadline);
+
+    leader_end();
+}
@@ -0,0 +1,266 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+using packet_t = std::vector<uint8_t>;
+
+#define PACKET_SIZE 32
+#define PAYLOAD_SIZE (PACKET_SIZE - 4)
+#define KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+class ViaBulkTransfer : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        EXPECT_CALL(driver, send_raw_hid_mock(_)).WillRepeatedly(Invoke([this](const packet_t& packet) { sent.push_back(packet); }));
+    }
+
+    // Sends a packet to the keyboard, returning everything it sent back
+    std::vector<packet_t> receive(std::initializer_list<uint8_t> bytes, const uint8_t* payload = nullptr, uint8_t payload_size = 0) {
+        uint8_t data[PACKET_SIZE] = {0};
+        std::copy(bytes.begin(), bytes.end(), data);
+        if (payload) {
+            std::copy(payload, payload + payload_size, &data[4]);
+        }
+        sent.clear();
+        raw_hid_receive(data, sizeof(data));
+        return sent;
+    }
+
+    std::vector<packet_t> begin(uint8_t command, uint8_t flags, uint16_t offset, uint16_t size, uint8_t window) {
+        return receive({id_dynamic_keymap_bulk_transfer, command, flags, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF), window});
+    }
+
+    std::vector<packet_t> ack(uint8_t seq) {
+        return receive({id_dynamic_keymap_bulk_transfer, id_bulk_ack, seq});
+    }
+
+    std::vector<packet_t> data(uint8_t seq, const std::vector<uint8_t>& payload, bool last) {
+        return receive({id_dynamic_keymap_bulk_transfer, id_bulk_data, seq, (uint8_t)(payload.size() | (last ? id_bulk_last : 0))}, payload.data(), payload.size());
+    }
+
+    static std::vector<uint8_t> keymap_buffer() {
+        std::vector<uint8_t> buffer(KEYMAP_SIZE);
+        dynamic_keymap_get_buffer(0, buffer.size(), buffer.data());
+        return buffer;
+    }
+
+    // Host side encoding, one packet payload per entry. Single keycodes are sent as literals of one, which is valid
+    // but not as compact as the keyboard's own encoding.
+    static std::vector<std::vector<uint8_t>> encode_rle(const std::vector<uint16_t>& keycodes) {
+        std::vector<std::vector<uint8_t>> payloads(1);
+        for (size_t i = 0; i < keycodes.size();) {
+            uint8_t run = 1;
+            while (i + run < keycodes.size() && run < DYNAMIC_KEYMAP_RLE_MAX_COUNT && keycodes[i + run] == keycodes[i]) {
+                run++;
+            }
+            if (payloads.back().size() + 3 > PAYLOAD_SIZE) {
+                payloads.emplace_back();
+            }
+            uint8_t token = run > 1 ? DYNAMIC_KEYMAP_RLE_RUN | run : 1;
+            payloads.back().insert(payloads.back().end(), {token, (uint8_t)(keycodes[i] >> 8), (uint8_t)(keycodes[i] & 0xFF)});
+            i += run;
+        }
+        return payloads;
+    }
+
+    // Decodes the payload of data packets
+    static std::vector<uint8_t> decode_rle(const std::vector<packet_t>& packets) {
+        std::vector<uint8_t> buffer;
+        for (const auto& packet : packets) {
+            uint8_t size = packet[3] & ~id_bulk_last;
+            for (uint8_t i = 4; i < 4 + size;) {
+                uint8_t count = packet[i] & DYNAMIC_KEYMAP_RLE_MAX_COUNT;
+                if (packet[i++] & DYNAMIC_KEYMAP_RLE_RUN) {
+                    for (uint8_t n = 0; n < count; n++) {
+                        buffer.insert(buffer.end(), {packet[i], packet[i + 1]});
+                    }
+                    i += 2;
+                } else {
+                    buffer.insert(buffer.end(), &packet[i], &packet[i + count * 2]);
+                    i += count * 2;
+                }
+            }
+        }
+        return buffer;
+    }
+
+    static std::vector<uint16_t> sample_keymap() {
+        // Layer 0 is mostly letters, the remaining layers mostly transparent
+        std::vector<uint16_t> keycodes(KEYMAP_SIZE / 2, KC_TRNS);
+        for (size_t i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
+            keycodes[i] = KC_A + i % 26;
+        }
+        keycodes[MATRIX_ROWS * MATRIX_COLS + 3]  = KC_1;
+        keycodes[MATRIX_ROWS * MATRIX_COLS + 4]  = KC_1;
+        keycodes[MATRIX_ROWS * MATRIX_COLS + 17] = KC_VOLU;
+        return keycodes;
+    }
+
+    static void set_keymap(const std::vector<uint16_t>& keycodes) {
+        for (size_t i = 0; i < keycodes.size(); i++) {
+            uint8_t data[2] = {(uint8_t)(keycodes[i] >> 8), (uint8_t)(keycodes[i] & 0xFF)};
+            dynamic_keymap_set_buffer(i * 2, 2, data);
+        }
+    }
+
+    static std::vector<uint8_t> to_buffer(const std::vector<uint16_t>& keycodes) {
+        std::vector<uint8_t> buffer;
+        for (auto keycode : keycodes) {
+            buffer.insert(buffer.end(), {(uint8_t)(keycode >> 8), (uint8_t)(keycode & 0xFF)});
+        }
+        return buffer;
+    }
+
+    TestDriver            driver;
+    std::vector<packet_t> sent;
+};
+
+TEST_F(ViaBulkTransfer, ReadRleStreamsWindows) {
+    set_keymap(sample_keymap());
+
+    auto reply = begin(id_bulk_read_begin, id_bulk_rle, 0, KEYMAP_SIZE, 16);
+    ASSERT_GE(reply.size(), 2);
+    EXPECT_EQ(reply[0][2], id_bulk_ok);
+    EXPECT_EQ(reply[0][3], VIA_BULK_TRANSFER_WINDOW) << "Window should be limited to VIA_BULK_TRANSFER_WINDOW";
+
+    std::vector<packet_t> packets(reply.begin() + 1, reply.end());
+    while (!(packets.back()[3] & id_bulk_last)) {
+        ASSERT_EQ(packets.size() % VIA_BULK_TRANSFER_WINDOW, 0) << "A full window should have been sent";
+        auto window = ack(packets.back()[2]);
+        ASSERT_FALSE(window.empty());
+        EXPECT_EQ(window[0][2], (uint8_t)(packets.back()[2] + 1)) << "Next window should follow the acknowledged packet";
+        packets.insert(packets.end(), window.begin(), window.end());
+    }
+    EXPECT_TRUE(ack(packets.back()[2]).empty()) << "Nothing should be sent once the last packet is acknowledged";
+
+    EXPECT_EQ(decode_rle(packets), keymap_buffer());
+    EXPECT_LT(packets.size(), KEYMAP_SIZE / PAYLOAD_SIZE / 2) << "Transparent layers should compress well";
+}
+
+TEST_F(ViaBulkTransfer, ReadRawMatchesBuffer) {
+    set_keymap(sample_keymap());
+
+    auto reply = begin(id_bulk_read_begin, 0, 6, 100, 8);
+    ASSERT_EQ(reply.size(), 1 + 4);
+    EXPECT_EQ(reply.back()[3], (100 - 3 * PAYLOAD_SIZE) | id_bulk_last);
+
+    std::vector<uint8_t> buffer;
+    for (auto it = reply.begin() + 1; it != reply.end(); ++it) {
+        buffer.insert(buffer.end(), it->begin() + 4, it->begin() + 4 + ((*it)[3] & ~id_bulk_last));
+    }
+    auto expected = keymap_buffer();
+    EXPECT_EQ(buffer, std::vector<uint8_t>(expected.begin() + 6, expected.begin() + 106));
+}
+
+TEST_F(ViaBulkTransfer, ReadResendsAfterLostPacket) {
+    auto reply = begin(id_bulk_read_begin, 0, 0, KEYMAP_SIZE, 4);
+    ASSERT_EQ(reply.size(), 1 + 4);
+
+    // Packet 1 went missing, so only packet 0 was received in order
+    auto resent = ack(0);
+    ASSERT_EQ(resent.size(), 4);
+    EXPECT_EQ(resent[0][2], 1);
+    EXPECT_EQ(resent[0], reply[2]) << "The lost packet should be resent unchanged";
+
+    // A duplicate ack resends the same window
+    EXPECT_EQ(ack(0), resent);
+}
+
+TEST_F(ViaBulkTransfer, WriteRleAcksOncePerWindow) {
+    auto keycodes = sample_keymap();
+    auto payloads = encode_rle(keycodes);
+    ASSERT_GT(payloads.size(), VIA_BULK_TRANSFER_WINDOW);
+
+    auto reply = begin(id_bulk_write_begin, id_bulk_rle, 0, KEYMAP_SIZE, VIA_BULK_TRANSFER_WINDOW);
+    ASSERT_EQ(reply.size(), 1);
+    EXPECT_EQ(reply[0][2], id_bulk_ok);
+
+    size_t acks = 0;
+    for (size_t seq = 0; seq < payloads.size(); seq++) {
+        bool last  = seq + 1 == payloads.size();
+        auto reply = data(seq, payloads[seq], last);
+        if ((seq + 1) % VIA_BULK_TRANSFER_WINDOW == 0 || last) {
+            ASSERT_EQ(reply.size(), 1) << "Packet " << seq << " should have been acknowledged";
+            EXPECT_EQ(reply[0][1], id_bulk_ack);
+            EXPECT_EQ(reply[0][2], seq);
+            EXPECT_EQ(reply[0][3], id_bulk_ok);
+            acks++;
+        } else {
+            EXPECT_TRUE(reply.empty()) << "Packet " << seq << " should not have been acknowledged";
+        }
+    }
+
+    EXPECT_EQ(acks, (payloads.size() + VIA_BULK_TRANSFER_WINDOW - 1) / VIA_BULK_TRANSFER_WINDOW);
+    EXPECT_EQ(keymap_buffer(), to_buffer(keycodes));
+}
+
+TEST_F(ViaBulkTransfer, WriteRequestsRetryAfterLostPacket) {
+    std::vector<uint8_t> first(PAYLOAD_SIZE, 0x11), second(PAYLOAD_SIZE, 0x22), third(PAYLOAD_SIZE, 0x33);
+    begin(id_bulk_write_begin, 0, 0, 3 * PAYLOAD_SIZE, VIA_BULK_TRANSFER_WINDOW);
+    EXPECT_TRUE(data(0, first, false).empty());
+
+    // Packet 1 went missing
+    auto reply = data(2, third, true);
+    ASSERT_EQ(reply.size(), 1);
+    EXPECT_EQ(reply[0][2], 0) << "Retry should refer to the last packet accepted";
+    EXPECT_EQ(reply[0][3], id_bulk_retry);
+    EXPECT_TRUE(data(3, third, true).empty()) << "Retry should only be requested once";
+
+    EXPECT_TRUE(data(1, second, false).empty());
+    reply = data(2, third, true);
+    ASSERT_EQ(reply.size(), 1);
+    EXPECT_EQ(reply[0][2], 2);
+    EXPECT_EQ(reply[0][3], id_bulk_ok);
+
+    std::vector<uint8_t> expected = first;
+    expected.insert(expected.end(), second.begin(), second.end());
+    expected.insert(expected.end(), third.begin(), third.end());
+    auto buffer = keymap_buffer();
+    EXPECT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + expected.size()), expected);
+}
+
+TEST_F(ViaBulkTransfer, MalformedRleAbortsWrite) {
+    begin(id_bulk_write_begin, id_bulk_rle, 0, 8, VIA_BULK_TRANSFER_WINDOW);
+
+    // A run of 5 keycodes doesn't fit in 8 bytes
+    auto reply = data(0, {DYNAMIC_KEYMAP_RLE_RUN | 5, 0x00, KC_A}, true);
+    ASSERT_EQ(reply.size(), 1);
+    EXPECT_EQ(reply[0][3], id_bulk_error);
+
+    reply = data(1, {0x01, 0x00, KC_A}, true);
+    ASSERT_EQ(reply.size(), 1);
+    EXPECT_EQ(reply[0][0], id_unhandled) << "The transfer should have been abandoned";
+}
+
+TEST_F(ViaBulkTransfer, InvalidBeginIsRejected) {
+    EXPECT_EQ(begin(id_bulk_read_begin, 0, 0, KEYMAP_SIZE + 1, 4)[0][2], id_bulk_error) << "Past the end of the keymap";
+    EXPECT_EQ(begin(id_bulk_read_begin, id_bulk_rle, 1, 10, 4)[0][2], id_bulk_error) << "Odd offset with RLE";
+    EXPECT_EQ(begin(id_bulk_write_begin, 0, 0, 10, 0)[0][2], id_bulk_error) << "Empty window";
+    EXPECT_EQ(ack(0)[0][0], id_unhandled) << "No transfer should be in progress";
+}
@@ -0,0 +1,7 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Generated by the firmware build, which the tests don't run
+#pragma once
+
+#define QMK_BUILDDATE "2026-01-01-00:00:00"
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "profiler.h"
 #include "usb_device_state.h"
 
 #ifdef DIGITIZER_ENABLE
@@ -141,7 +142,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
-    (*driver->send_keyboard)(report);
+    PROFILER_CALL_NAMED("host_keyboard_send", (*driver->send_keyboard)(report));
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);